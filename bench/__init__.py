@@ -0,0 +1 @@
+"""Benchmarks for the autonomous development team's hot paths."""
@@ -0,0 +1,112 @@
+"""
+JSON Codec Benchmark.
+
+Measures tool-call throughput with each installed codec. Every call
+pays the same JSON costs as over HTTP (client request encode, server
+decode, server response encode, client decode), runs the real handler
+against a ContextStore with its journal on disk, and writes one log
+line. Each task goes through create_task, fetch_task,
+update_task_status and complete_task with a realistically sized
+result.
+
+Usage:
+    python3 -m bench.bench_codec --tasks 500
+"""
+
+import argparse
+import asyncio
+import json
+import os
+import tempfile
+import time
+
+from logging import codec
+from logging.json_logger import JSONLogger
+from logging.log_writer import close_log_writers
+from mcp_server.context_store import ContextStore
+from mcp_server.tools import register_tools
+
+from .bench_sanitizer import make_task_result
+
+
+def available_codecs():
+    """Names of the codecs whose packages are installed."""
+    names = []
+    for name, codec_class in codec.CODECS.items():
+        try:
+            codec_class()
+            names.append(name)
+        except ImportError:
+            pass
+    return names
+
+
+async def call(tools, logger, tool_name: str, params: dict) -> dict:
+    """One tool call with HTTP-equivalent encoding on both sides."""
+    request = codec.dumps_bytes({"params": params})
+    body = codec.loads(request)
+    result = await tools[tool_name]["handler"](body["params"])
+    response = codec.dumps_bytes(result)
+    logger.log_sync("tool_call", {"tool": tool_name, "bytes": len(request) + len(response)}, sanitized=True)
+    return codec.loads(response)
+
+
+async def run(name: str, tasks: int, workdir: str) -> dict:
+    """
+    Drive a full task lifecycle per task with one codec.
+
+    Returns:
+        Result row for the codec
+    """
+    codec.set_codec(name)
+    store = ContextStore(os.path.join(workdir, name, "store.json"))
+    tools = register_tools(store)
+    logger = JSONLogger("mcp_server", f"bench-{name}", os.path.join(workdir, name, "bench.log"))
+    result = make_task_result(0)
+
+    calls = 0
+    start = time.perf_counter()
+    for i in range(tasks):
+        await call(tools, logger, "create_task", {
+            "task_id": f"task-{i:06d}",
+            "description": f"Implement endpoint {i}",
+            "required_capabilities": ["python"],
+            "estimated_hours": 2
+        })
+        fetched = await call(tools, logger, "fetch_task", {"worker_id": "worker-001", "capabilities": ["python"]})
+        task_id = fetched["task"]["id"]
+        await call(tools, logger, "update_task_status", {
+            "task_id": task_id, "status": "in_progress", "progress": 50, "worker_id": "worker-001"
+        })
+        await call(tools, logger, "complete_task", {"task_id": task_id, "result": result, "worker_id": "worker-001"})
+        calls += 4
+    elapsed = time.perf_counter() - start
+
+    return {
+        "codec": name,
+        "calls": calls,
+        "seconds": round(elapsed, 3),
+        "calls_per_second": round(calls / elapsed, 1)
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="JSON codec tool-call throughput benchmark")
+    parser.add_argument("--tasks", type=int, default=500, help="Tasks taken through their lifecycle per codec")
+    args = parser.parse_args()
+
+    previous = codec.get_codec().name
+    with tempfile.TemporaryDirectory() as workdir:
+        rows = [asyncio.run(run(name, args.tasks, workdir)) for name in available_codecs()]
+        close_log_writers()
+    codec.set_codec(previous)
+
+    baseline = next(row for row in rows if row["codec"] == "json")
+    for row in rows:
+        row["speedup"] = round(row["calls_per_second"] / baseline["calls_per_second"], 2)
+
+    print(json.dumps({"benchmark": "codec", "tasks": args.tasks, "results": rows}))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,166 @@
+"""
+Context Store Contention Benchmark.
+
+Simulates 8, 32 and 128 workers against one ContextStore. Each worker
+claims a task, reports progress and completes it with a realistically
+sized result. A status reader polls the project status, and the lead
+keeps adding tasks in batch transactions. Every call waits for its
+mutations to reach disk before returning, as the MCP server does.
+
+Runs each worker count twice: with journal and snapshot I/O done inline
+under the store lock (as before), and on the journal's writer thread.
+Reports task throughput, claim and status-read latency, store lock wait
+and event loop stalls.
+
+Usage:
+    python3 -m bench.bench_contention --tasks-per-worker 20 --fsync
+"""
+
+import argparse
+import asyncio
+import json
+import os
+import statistics
+import tempfile
+import time
+from typing import Dict, List
+
+from mcp_server.context_store import ContextStore
+from mcp_server.tools import register_tools
+
+from .bench_sanitizer import make_task_result
+
+
+def percentile(samples: List[float], fraction: float) -> float:
+    """Percentile of latency samples, in milliseconds."""
+    if not samples:
+        return 0.0
+    ordered = sorted(samples)
+    return round(ordered[min(int(len(ordered) * fraction), len(ordered) - 1)] * 1000, 3)
+
+
+async def call(store: ContextStore, tools: dict, tool_name: str, params: dict) -> dict:
+    """One tool call, replying only once its mutations are on disk."""
+    result = await tools[tool_name]["handler"](params)
+    await store.flush()
+    return result
+
+
+async def run(workers: int, tasks_per_worker: int, background: bool, fsync: bool, workdir: str) -> dict:
+    """
+    Drive one simulated cluster to completion.
+
+    Returns:
+        Result row
+    """
+    mode = "background" if background else "inline"
+    store = ContextStore(
+        os.path.join(workdir, f"{mode}-{workers}", "store.json"),
+        snapshot_interval=200,
+        fsync=fsync,
+        background_persistence=background
+    )
+    tools = register_tools(store)
+    result = make_task_result(0)
+    total = workers * tasks_per_worker
+    latencies: Dict[str, List[float]] = {"claim": [], "status": []}
+    stalls: List[float] = []
+    finished = asyncio.Event()
+
+    async def lead():
+        # Tasks arrive in batches while workers are already claiming
+        for start in range(0, total, 25):
+            async with store.transaction():
+                for i in range(start, min(start + 25, total)):
+                    await tools["create_task"]["handler"]({
+                        "task_id": f"task-{i:06d}",
+                        "description": f"Implement endpoint {i}",
+                        "required_capabilities": ["python"],
+                        "estimated_hours": 2
+                    })
+                    await asyncio.sleep(0)
+            await store.flush()
+
+    async def worker(n: int):
+        worker_id = f"worker-{n:03d}"
+        done = 0
+        while done < tasks_per_worker:
+            started = time.perf_counter()
+            fetched = await call(store, tools, "fetch_task", {
+                "worker_id": worker_id, "capabilities": ["python"], "wait_seconds": 1
+            })
+            latencies["claim"].append(time.perf_counter() - started)
+            task = fetched.get("task")
+            if not task:
+                continue
+            await call(store, tools, "update_task_status", {
+                "task_id": task["id"], "status": "in_progress", "progress": 50, "worker_id": worker_id
+            })
+            await call(store, tools, "complete_task", {"task_id": task["id"], "result": result, "worker_id": worker_id})
+            done += 1
+
+    async def status_reader():
+        while not finished.is_set():
+            started = time.perf_counter()
+            await call(store, tools, "get_project_status", {})
+            latencies["status"].append(time.perf_counter() - started)
+            await asyncio.sleep(0.005)
+
+    async def stall_monitor():
+        # How late a 1ms timer fires = how long the loop was blocked
+        while not finished.is_set():
+            started = time.perf_counter()
+            await asyncio.sleep(0.001)
+            stalls.append(time.perf_counter() - started - 0.001)
+
+    background_tasks = [asyncio.create_task(status_reader()), asyncio.create_task(stall_monitor())]
+    started = time.perf_counter()
+    await asyncio.gather(lead(), *(worker(n) for n in range(workers)))
+    elapsed = time.perf_counter() - started
+    finished.set()
+    await asyncio.gather(*background_tasks)
+    store.close()
+
+    lock_wait = sum(
+        value for suffix, labels, value in store._lock_wait_seconds.samples()
+        if suffix == "_sum" and 'lock="store"' in labels
+    )
+    return {
+        "workers": workers,
+        "mode": mode,
+        "tasks": total,
+        "seconds": round(elapsed, 3),
+        "tasks_per_second": round(total / elapsed, 1),
+        "claim_p50_ms": percentile(latencies["claim"], 0.50),
+        "claim_p99_ms": percentile(latencies["claim"], 0.99),
+        "status_p50_ms": percentile(latencies["status"], 0.50),
+        "status_p99_ms": percentile(latencies["status"], 0.99),
+        "lock_wait_total_ms": round(lock_wait * 1000, 1),
+        "loop_stall_p99_ms": percentile(stalls, 0.99),
+        "loop_stall_mean_ms": round(statistics.fmean(stalls) * 1000, 3) if stalls else 0.0
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Context store contention benchmark")
+    parser.add_argument("--workers", type=int, nargs="+", default=[8, 32, 128], help="Simulated worker counts")
+    parser.add_argument("--tasks-per-worker", type=int, default=20, help="Tasks each worker completes")
+    parser.add_argument("--fsync", action="store_true", help="Fsync every journal write")
+    args = parser.parse_args()
+
+    rows = []
+    with tempfile.TemporaryDirectory() as workdir:
+        for workers in args.workers:
+            for background in (False, True):
+                rows.append(asyncio.run(run(workers, args.tasks_per_worker, background, args.fsync, workdir)))
+
+    print(json.dumps({
+        "benchmark": "contention",
+        "tasks_per_worker": args.tasks_per_worker,
+        "fsync": args.fsync,
+        "results": rows
+    }))
+
+
+if __name__ == "__main__":
+    main()
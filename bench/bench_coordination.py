@@ -0,0 +1,290 @@
+"""
+MCP Coordination Benchmark.
+
+Launches an MCPServer and drives a synthetic project through it: the
+lead publishes a generated task DAG with create_tasks while simulated
+zero-latency workers (the real Worker, with task execution replaced by
+an instant result) claim and complete tasks, and the run ends on the
+store's all_tasks_terminal event.
+
+Reports claim throughput and time to first claim, client-side tool-call
+p50/p99, store persistence time and bytes on disk per task, and log
+bytes per task, as one JSON document. With --baseline, results are
+compared to an earlier run and the exit status is 1 if throughput or
+p99 latency regressed beyond --tolerance.
+
+Usage:
+    python3 -m bench.bench_coordination --tasks 10 1000 10000 --workers 8 --shape layered
+    python3 -m bench.bench_coordination --tasks 1000 --output current.json --baseline previous.json
+"""
+
+import argparse
+import asyncio
+import json
+import os
+import sys
+import tempfile
+import time
+from typing import Dict, List, Optional
+
+from logging.log_writer import close_log_writers
+from mcp_server.server import MCPServer
+from workers.mcp_client import MCPClient, register_in_process_server, unregister_in_process_server
+from workers.worker import Worker, WorkerType
+
+from .bench_contention import percentile
+from .bench_sanitizer import make_task_result
+from .workload import CAPABILITY_DISTRIBUTIONS, SHAPES, generate_workload
+
+
+# Tasks per create_tasks call when publishing the workload
+PUBLISH_CHUNK = 500
+
+# Fields compared against a baseline: (field, True if higher is better)
+REGRESSION_FIELDS = (
+    ("claims_per_second", True),
+    ("claim_p99_ms", False),
+    ("complete_task_p99_ms", False),
+    ("persist_ms_per_task", False)
+)
+
+
+class SimulatedWorker(Worker):
+    """Worker that finishes every task instantly and times its tool calls."""
+
+    def __init__(self, *args, latencies: Dict[str, List[float]], claims: List[float], **kwargs):
+        """
+        Initialize the worker.
+
+        Args:
+            latencies: Per-tool call latencies, appended to ("claim" holds
+                fetch_task calls that returned a task; empty long-polls
+                only count under fetch_task)
+            claims: perf_counter() time of every successful claim, appended to
+            *args, **kwargs: Passed to Worker
+        """
+        super().__init__(*args, **kwargs)
+        self.fetch_wait_seconds = 1.0
+        self.claims = claims
+
+        call_tool = self.mcp_client.call_tool
+
+        async def timed_call_tool(tool_name: str, params: dict, **call_kwargs) -> dict:
+            started = time.perf_counter()
+            try:
+                return await call_tool(tool_name, params, **call_kwargs)
+            finally:
+                latencies.setdefault(tool_name, []).append(time.perf_counter() - started)
+
+        self.mcp_client.call_tool = timed_call_tool
+        self.latencies = latencies
+        self.result = make_task_result(0)
+
+    async def fetch_eligible_task(self) -> Optional[dict]:
+        started = time.perf_counter()
+        task = await super().fetch_eligible_task()
+        if task:
+            self.claims.append(time.perf_counter())
+            self.latencies.setdefault("claim", []).append(self.claims[-1] - started)
+        return task
+
+    async def execute_task_iterative(self, task: dict) -> dict:
+        self.emit_output(task["id"], f"{task['id']} done\n")
+        return self.result
+
+
+def directory_bytes(path: str, exclude: Optional[str] = None) -> int:
+    """Total size of the files under path (skipping the exclude subdirectory)."""
+    total = 0
+    for root, dirs, files in os.walk(path):
+        if exclude is not None:
+            dirs[:] = [d for d in dirs if os.path.join(root, d) != exclude]
+        total += sum(os.path.getsize(os.path.join(root, name)) for name in files)
+    return total
+
+
+async def wait_until_done(client: MCPClient, total: int):
+    """Follow store events until every task is completed or failed."""
+    cursor = 0
+    while True:
+        result = await client.call_tool("wait_for_events", {"after": cursor, "wait_seconds": 5})
+        cursor = result.get("next", cursor)
+        terminal = any(event["type"] == "all_tasks_terminal" for event in result.get("events", []))
+        if terminal or result.get("reset"):
+            metrics = (await client.call_tool("get_project_status", {}))["status"]["metrics"]
+            if metrics["total_tasks"] >= total and metrics["completed_tasks"] + metrics["failed_tasks"] >= total:
+                return
+
+
+async def run(
+    tasks: int,
+    shape: str,
+    capabilities: str,
+    worker_count: int,
+    transport: str,
+    backend: str,
+    port: int,
+    workdir: str
+) -> dict:
+    """
+    Drive one synthetic project to completion.
+
+    Returns:
+        Result row
+    """
+    run_dir = os.path.join(workdir, f"{shape}-{capabilities}-{tasks}-{worker_count}-{transport}-{backend}")
+    log_dir = os.path.join(run_dir, "logs")
+    log_file = os.path.join(log_dir, "activity.log")
+    host = "127.0.0.1"
+
+    server = MCPServer(
+        host=host,
+        port=port,
+        context_store_path=os.path.join(run_dir, "context", "store.json"),
+        log_file=log_file,
+        storage_backend=backend,
+        result_cache=False
+    )
+    if transport == "in_process":
+        register_in_process_server(server, host, port)
+    else:
+        await server.start()
+
+    workload = generate_workload(tasks, shape, capabilities)
+    latencies: Dict[str, List[float]] = {}
+    claims: List[float] = []
+    worker_types = list(WorkerType)
+    workers = [
+        SimulatedWorker(
+            f"bench-{n:03d}",
+            worker_types[n % len(worker_types)],
+            mcp_host=host,
+            mcp_port=port,
+            log_file=log_file,
+            latencies=latencies,
+            claims=claims
+        )
+        for n in range(worker_count)
+    ]
+    lead = MCPClient(host, port)
+
+    started = time.perf_counter()
+    loops = [asyncio.create_task(worker.work_loop()) for worker in workers]
+    publish_seconds = 0.0
+
+    async with lead:
+        await lead.call_tool("analyze_requirements", {"text": f"Synthetic {shape} project with {tasks} tasks"})
+        for start in range(0, tasks, PUBLISH_CHUNK):
+            published = time.perf_counter()
+            await lead.call_tool("create_tasks", {"tasks": workload[start:start + PUBLISH_CHUNK]})
+            publish_seconds += time.perf_counter() - published
+        await wait_until_done(lead, tasks)
+    elapsed = time.perf_counter() - started
+
+    for worker in workers:
+        await worker.stop()
+    await asyncio.gather(*loops, return_exceptions=True)
+    await server.stop()
+    if transport == "in_process":
+        unregister_in_process_server(host, port)
+    close_log_writers()
+
+    persist = {
+        labels: value for suffix, labels, value in server.context_store._persist_seconds.samples()
+        if suffix == "_sum"
+    }
+    persist_seconds = sum(persist.values())
+
+    row = {
+        "tasks": tasks,
+        "shape": shape,
+        "capabilities": capabilities,
+        "workers": worker_count,
+        "transport": transport,
+        "backend": backend,
+        "seconds": round(elapsed, 3),
+        "claims_per_second": round(len(claims) / elapsed, 1),
+        "first_claim_ms": round((min(claims) - started) * 1000, 3) if claims else None,
+        "publish_ms": round(publish_seconds * 1000, 3),
+        "persist_ms_per_task": round(persist_seconds * 1000 / tasks, 4),
+        "persist_ms_by_kind": {labels: round(value * 1000, 3) for labels, value in persist.items()},
+        "store_bytes_per_task": round(directory_bytes(run_dir, exclude=log_dir) / tasks, 1),
+        "log_bytes_per_task": round(directory_bytes(log_dir) / tasks, 1)
+    }
+    for tool_name in sorted(latencies):
+        row[f"{tool_name}_calls"] = len(latencies[tool_name])
+        row[f"{tool_name}_p50_ms"] = percentile(latencies[tool_name], 0.50)
+        row[f"{tool_name}_p99_ms"] = percentile(latencies[tool_name], 0.99)
+    return row
+
+
+def row_key(row: dict) -> tuple:
+    """Identify a result row across runs."""
+    return tuple(row.get(field) for field in ("tasks", "shape", "capabilities", "workers", "transport", "backend"))
+
+
+def find_regressions(rows: List[dict], baseline: List[dict], tolerance: float) -> List[dict]:
+    """
+    Compare rows to the matching baseline rows.
+
+    Returns:
+        One entry per field that got worse by more than tolerance
+    """
+    previous = {row_key(row): row for row in baseline}
+    regressions = []
+    for row in rows:
+        before = previous.get(row_key(row))
+        if before is None:
+            continue
+        for field, higher_is_better in REGRESSION_FIELDS:
+            old, new = before.get(field), row.get(field)
+            if not old or new is None:
+                continue
+            change = (new - old) / old
+            if (-change if higher_is_better else change) > tolerance:
+                regressions.append({"key": list(row_key(row)), "field": field, "baseline": old, "current": new})
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="MCP coordination path benchmark")
+    parser.add_argument("--tasks", type=int, nargs="+", default=[10, 1000], help="Task counts (10 to 100000)")
+    parser.add_argument("--shape", choices=SHAPES, default="layered", help="Task DAG shape")
+    parser.add_argument("--capabilities", choices=sorted(CAPABILITY_DISTRIBUTIONS), default="uniform",
+                        help="How required capabilities are spread over worker types")
+    parser.add_argument("--workers", type=int, nargs="+", default=[8], help="Simulated worker counts")
+    parser.add_argument("--transport", choices=["in_process", "http"], default="in_process",
+                        help="How workers reach the server")
+    parser.add_argument("--backend", choices=["journal", "sqlite"], default="journal", help="Context store backend")
+    parser.add_argument("--port", type=int, default=18080, help="First server port (one per run)")
+    parser.add_argument("--output", help="Also write the results to this file")
+    parser.add_argument("--baseline", help="Results file of an earlier run to compare against")
+    parser.add_argument("--tolerance", type=float, default=0.25, help="Allowed relative regression")
+    args = parser.parse_args()
+
+    rows = []
+    with tempfile.TemporaryDirectory() as workdir:
+        for workers in args.workers:
+            for tasks in args.tasks:
+                rows.append(asyncio.run(run(
+                    tasks, args.shape, args.capabilities, workers,
+                    args.transport, args.backend, args.port + len(rows), workdir
+                )))
+
+    document = {"benchmark": "coordination", "results": rows}
+    if args.baseline:
+        with open(args.baseline) as f:
+            document["regressions"] = find_regressions(rows, json.load(f)["results"], args.tolerance)
+
+    output = json.dumps(document)
+    print(output)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(output)
+
+    if document.get("regressions"):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+"""
+Sanitizer Microbenchmark.
+
+Compares the precompiled, memoized sanitizer in logging.json_logger
+with the original per-key substring scan on large task results.
+
+Usage:
+    python3 -m bench.bench_sanitizer --results 200 --iterations 50
+"""
+
+import argparse
+import json
+import time
+from typing import Any
+
+from logging.json_logger import sanitize
+
+
+LEGACY_SENSITIVE_KEYS = {
+    "password",
+    "api_key",
+    "secret",
+    "token",
+    "authorization",
+    "auth",
+    "credential",
+    "access_token",
+    "refresh_token",
+    "private_key",
+    "jwt"
+}
+
+
+def legacy_sanitize(data: Any) -> Any:
+    """Sanitizer as it was before precompilation (baseline)."""
+    def _sanitize(obj):
+        if isinstance(obj, dict):
+            return {
+                k: "***REDACTED***" if any(sens in k.lower() for sens in LEGACY_SENSITIVE_KEYS)
+                else _sanitize(v)
+                for k, v in obj.items()
+            }
+        elif isinstance(obj, list):
+            return [_sanitize(item) for item in obj]
+        return obj
+
+    return _sanitize(data)
+
+
+def make_task_result(index: int) -> dict:
+    """Build a task result shaped like a worker's completed output."""
+    return {
+        "task_id": f"task-{index:08d}",
+        "status": "completed",
+        "description": "Implement authentication system " * 4,
+        "steps_executed": 5,
+        "artifacts": [
+            {
+                "path": f"src/module_{index}_{n}.py",
+                "language": "python",
+                "lines": 120 + n,
+                "checksum": f"{index:08x}{n:08x}",
+                "metadata": {"author": "worker-001", "reviewed": False, "tags": ["api", "auth"]}
+            }
+            for n in range(10)
+        ],
+        "test_results": {"passed": 42, "failed": 0, "skipped": 1, "duration_ms": 1532.5},
+        "config": {"database_url": "postgresql://db/app", "api_key": "sk-test", "debug": False},
+        "notes": "Task executed successfully"
+    }
+
+
+def time_it(func, payload, iterations: int) -> float:
+    """Return mean seconds per call."""
+    start = time.perf_counter()
+    for _ in range(iterations):
+        func(payload)
+    return (time.perf_counter() - start) / iterations
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Sanitizer microbenchmark")
+    parser.add_argument("--results", type=int, default=200, help="Task results per payload")
+    parser.add_argument("--iterations", type=int, default=50, help="Iterations per measurement")
+    args = parser.parse_args()
+
+    payload = {"results": [make_task_result(i) for i in range(args.results)]}
+
+    # Both implementations must agree before timing means anything
+    assert json.dumps(sanitize(payload), sort_keys=True) == json.dumps(legacy_sanitize(payload), sort_keys=True)
+
+    legacy = time_it(legacy_sanitize, payload, args.iterations)
+    fast = time_it(sanitize, payload, args.iterations)
+
+    print(json.dumps({
+        "benchmark": "sanitizer",
+        "payload_bytes": len(json.dumps(payload)),
+        "iterations": args.iterations,
+        "legacy_ms": round(legacy * 1000, 3),
+        "fast_ms": round(fast * 1000, 3),
+        "speedup": round(legacy / fast, 2)
+    }))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+"""
+Synthetic Workload Generator.
+
+Builds task DAGs for the coordination benchmark: a shape (how tasks
+depend on each other), a task count and a distribution of required
+capabilities over the worker profiles. Every generated task can be run
+by at least one worker type.
+"""
+
+import random
+from typing import Dict, List
+
+from workers.worker import WorkerCapabilities, WorkerType
+
+
+# Task DAG shapes
+SHAPES = ("independent", "chain", "fanout", "layered")
+
+# How often each worker type's capabilities are required
+CAPABILITY_DISTRIBUTIONS = {
+    "uniform": {worker_type: 1.0 for worker_type in WorkerType},
+    "skewed": {
+        WorkerType.DEVELOPER: 0.7,
+        WorkerType.TESTER: 0.2,
+        WorkerType.DEVOPS: 0.08,
+        WorkerType.ARCHITECT: 0.02
+    }
+}
+
+
+def _dependencies(shape: str, index: int, width: int, rng: random.Random) -> List[int]:
+    """Indexes of the tasks task index depends on (always lower indexes)."""
+    if index == 0 or shape == "independent":
+        return []
+    if shape == "chain":
+        return [index - 1]
+    if shape == "fanout":
+        # One root everything else depends on
+        return [0]
+
+    # layered: width tasks per layer, each depending on up to 3 tasks of the layer before
+    layer = index // width
+    if layer == 0:
+        return []
+    previous = range((layer - 1) * width, layer * width)
+    return sorted(rng.sample(previous, min(3, len(previous))))
+
+
+def generate_workload(
+    tasks: int,
+    shape: str = "layered",
+    capabilities: str = "uniform",
+    width: int = 32,
+    seed: int = 0
+) -> List[dict]:
+    """
+    Generate create_task parameters for a synthetic project.
+
+    Args:
+        tasks: Number of tasks
+        shape: One of SHAPES
+        capabilities: Key of CAPABILITY_DISTRIBUTIONS
+        width: Tasks per layer for the layered shape
+        seed: Random seed (the same arguments always give the same workload)
+
+    Returns:
+        Tasks in dependency order (a task only depends on earlier ones)
+
+    Raises:
+        ValueError: If shape or capabilities is unknown
+    """
+    if shape not in SHAPES:
+        raise ValueError(f"Unknown shape: {shape}")
+    if capabilities not in CAPABILITY_DISTRIBUTIONS:
+        raise ValueError(f"Unknown capability distribution: {capabilities}")
+
+    rng = random.Random(seed)
+    weights: Dict[WorkerType, float] = CAPABILITY_DISTRIBUTIONS[capabilities]
+    worker_types = list(weights)
+    ids = [f"task-{i:06d}" for i in range(tasks)]
+
+    workload = []
+    for i in range(tasks):
+        worker_type = rng.choices(worker_types, weights=[weights[t] for t in worker_types])[0]
+        profile = WorkerCapabilities.PROFILES[worker_type]["capabilities"]
+        workload.append({
+            "task_id": ids[i],
+            "description": f"Synthetic task {i} ({worker_type.value})",
+            "dependencies": [ids[d] for d in _dependencies(shape, i, max(1, width), rng)],
+            "required_capabilities": rng.sample(profile, rng.randint(1, 2)),
+            "estimated_hours": rng.choice((1, 2, 4, 8))
+        })
+    return workload
@@ -92,6 +92,26 @@ class ProjectConfig:
         """Get MCP request timeout in seconds."""
         return self.config.get("mcp_server", {}).get("request_timeout", 30.0)
 
+    @property
+    def mcp_transport(self) -> str:
+        """Get how local components reach the MCP server (in_process or http)."""
+        return self.config.get("mcp_server", {}).get("transport", "in_process")
+
+    @property
+    def context_store_path(self) -> str:
+        """Get context store snapshot path."""
+        return self.config.get("context_store", {}).get("path", "context/project_store.json")
+
+    @property
+    def context_store_backend(self) -> str:
+        """Get context store backend (journal or sqlite)."""
+        return self.config.get("context_store", {}).get("backend", "journal")
+
+    @property
+    def context_store_result_cache(self) -> bool:
+        """Get whether results are reused for tasks identical to earlier ones."""
+        return self.config.get("context_store", {}).get("result_cache", True)
+
     @property
     def log_level(self) -> str:
         """Get logging level."""
@@ -102,6 +122,18 @@ class ProjectConfig:
         """Check if network I/O logging is enabled."""
         return self.config.get("logging", {}).get("include_network_io", True)
 
+    @property
+    def network_log_policy(self) -> Dict[str, Any]:
+        """
+        Get network I/O logging policy options.
+
+        Returns mode "off" when network logging is disabled.
+        """
+        options = dict(self.config.get("logging", {}).get("network_io", {}))
+        if not self.enable_network_logging:
+            options["mode"] = "off"
+        return options
+
     @property
     def log_file(self) -> str:
         """Get log file path."""
@@ -122,11 +154,51 @@ class ProjectConfig:
         """Get log retention period in days."""
         return self.config.get("logging", {}).get("retention_days", 30)
 
+    @property
+    def log_compression(self) -> str:
+        """Get compression for rotated log segments (none, gzip, zstd)."""
+        return self.config.get("logging", {}).get("compression", "none")
+
+    @property
+    def log_index_segments(self) -> bool:
+        """Check whether rotated log segments get a sidecar index for log analysis."""
+        return self.config.get("logging", {}).get("index_segments", True)
+
+    @property
+    def log_queue_size(self) -> int:
+        """Get maximum number of log lines buffered for the background writer."""
+        return self.config.get("logging", {}).get("queue_size", 10000)
+
+    @property
+    def log_flush_interval_ms(self) -> int:
+        """Get maximum time a log line stays buffered, in milliseconds."""
+        return self.config.get("logging", {}).get("flush_interval_ms", 500)
+
+    @property
+    def log_flush_bytes(self) -> int:
+        """Get number of buffered log bytes that triggers a write."""
+        return self.config.get("logging", {}).get("flush_bytes", 65536)
+
+    @property
+    def log_fsync_policy(self) -> str:
+        """Get log fsync policy (never, batch, always)."""
+        return self.config.get("logging", {}).get("fsync", "never")
+
+    @property
+    def log_overflow_policy(self) -> str:
+        """Get policy for a full log queue (block, drop_newest, drop_oldest)."""
+        return self.config.get("logging", {}).get("overflow", "block")
+
     @property
     def display_refresh_rate_hz(self) -> float:
         """Get display refresh rate in Hz."""
         return self.config.get("display", {}).get("refresh_rate_hz", 1.0)
 
+    @property
+    def display_max_redraw_hz(self) -> float:
+        """Get upper bound on terminal redraws per second."""
+        return self.config.get("display", {}).get("max_redraw_hz", 10.0)
+
     @property
     def display_show_network_io_realtime(self) -> bool:
         """Check if real-time network I/O should be displayed."""
@@ -3,7 +3,7 @@ Terminal Status Display for Autonomous Development Team.
 
 Provides a live, interactive terminal UI showing:
 - Project overview and progress
-- Individual worker status
+- Individual worker status, with the latest output of running tasks
 - Recent activity log
 - Overall metrics
 """
@@ -21,7 +21,8 @@ from rich.table import Table
 from rich.live import Live
 from rich.text import Text
 
-from workers.worker import MCPClient, Worker
+from workers.mcp_client import MCPClient
+from workers.worker import Worker
 from project_lead.lead import ProjectLead
 
 
@@ -34,6 +35,11 @@ class TerminalStatusDisplay:
     - Worker panels (2-8 workers)
     - Recent activity log
     - Footer with task statistics
+
+    Panels are only rebuilt when their inputs change, and the terminal is
+    only redrawn when at least one panel is dirty. Redraws are spaced so
+    rendering stays within render_budget of wall time, and never exceed
+    max_redraw_hz.
     """
 
     def __init__(
@@ -42,7 +48,9 @@ class TerminalStatusDisplay:
         workers: List[Worker],
         mcp_host: str = "localhost",
         mcp_port: int = 8080,
-        refresh_rate: float = 1.0
+        refresh_rate: float = 1.0,
+        max_redraw_hz: float = 10.0,
+        render_budget: float = 0.1
     ):
         """
         Initialize terminal status display.
@@ -53,15 +61,41 @@ class TerminalStatusDisplay:
             mcp_host: MCP server host
             mcp_port: MCP server port
             refresh_rate: Refresh rate in seconds
+            max_redraw_hz: Upper bound on terminal redraws per second
+            render_budget: Fraction of wall time redraws may take
         """
         self.console = Console()
         self.project_lead = project_lead
         self.workers = workers
         self.refresh_rate = refresh_rate
+        self.min_redraw_interval = 1.0 / max_redraw_hz if max_redraw_hz > 0 else 0.0
+        self.render_budget = render_budget
+
+        # Dirty tracking: last input signature per panel and panels awaiting a redraw
+        self._panel_signatures: Dict[str, Any] = {}
+        self._dirty: set = set()
+        self._activity_version = 0
+
+        # Frame statistics
+        self.live: Optional[Live] = None
+        self.frame_ms = 0.0
+        self.frames_drawn = 0
+        self._last_redraw = 0.0
 
         # Initialize MCP client for status queries
         self.mcp_client = MCPClient(mcp_host, mcp_port)
 
+        # Status mirror, kept current with get_project_status deltas
+        self.status_version = 0
+        self.status_epoch: Optional[str] = None
+        self.known_tasks: Dict[str, dict] = {}
+        self.known_workers: Dict[str, dict] = {}
+
+        # Live output tail per running task: next offset to read and last line seen
+        self.output_offsets: Dict[str, int] = {}
+        self.output_tails: Dict[str, str] = {}
+        self.max_tail_chars = 60
+
         # Activity log
         self.activity_log = []
         self.max_activity_entries = 10
@@ -69,8 +103,9 @@ class TerminalStatusDisplay:
         # Project start time
         self.start_time = datetime.now()
 
-        # Layout
+        # Layout (rebuilt when the worker pool grows or shrinks)
         self.layout = self._create_layout()
+        self._layout_worker_ids = [w.worker_id for w in self.workers]
 
     def _create_layout(self) -> Layout:
         """
@@ -183,25 +218,25 @@ class TerminalStatusDisplay:
         workers_info = status.get("workers", {})
         worker_info = workers_info.get(worker.worker_id, {})
 
-        # Determine current task
-        current_task = "IDLE"
-        progress = 0
-
-        if worker.current_task:
-            task_id = worker.current_task.get("id", "unknown")
-            current_task = task_id
-            progress = worker.current_task.get("progress", 0)
-
-        progress_bar = self._render_progress_bar(progress)
+        # One line per slot, running tasks first
+        slot_lines = []
+        for task in worker.current_tasks.values():
+            progress = task.get("progress", 0)
+            progress_bar = self._render_progress_bar(progress)
+            line = f"{task.get('id', 'unknown')}: {progress_bar} {progress}%"
+            tail = self.output_tails.get(task.get("id"))
+            if tail:
+                line += f" {tail}"
+            slot_lines.append(line)
+        slot_lines.extend(["IDLE"] * (worker.max_concurrent_tasks - len(slot_lines)))
 
         # Determine border color based on status
         border_style = "green" if worker.is_active else "red"
 
         panel_text = (
             f"Worker {worker.worker_id} ({worker.worker_type.value})\n"
-            f"Task: {current_task}\n"
-            f"Progress: {progress_bar} {progress}%\n"
-            f"Status: {worker.status}"
+            + "\n".join(slot_lines) + "\n"
+            f"Status: {worker.status} ({len(worker.current_tasks)}/{worker.max_concurrent_tasks} slots)"
         )
 
         return Panel(
@@ -246,18 +281,14 @@ class TerminalStatusDisplay:
         Returns:
             Panel instance
         """
-        tasks_by_status = status.get("tasks_by_status", {})
-
-        completed = tasks_by_status.get("completed", 0)
-        in_progress = tasks_by_status.get("in_progress", 0)
-        failed = tasks_by_status.get("failed", 0)
-        pending = tasks_by_status.get("pending", 0)
+        completed, in_progress, failed, pending = self._footer_counts(status)
 
         footer_text = (
             f"Completed: {completed} | "
             f"Active: {in_progress} | "
             f"Failed: {failed} | "
-            f"Queue: {pending}"
+            f"Queue: {pending} | "
+            f"Frame: {self.frame_ms:.1f}ms"
         )
 
         return Panel(
@@ -266,6 +297,84 @@ class TerminalStatusDisplay:
             border_style="white"
         )
 
+    @staticmethod
+    def _footer_counts(status: dict) -> tuple:
+        """Task counts shown in the footer: completed, in progress, failed, pending."""
+        tasks_by_status = status.get("tasks_by_status", {})
+        return (
+            tasks_by_status.get("completed", 0),
+            tasks_by_status.get("in_progress", 0),
+            tasks_by_status.get("failed", 0),
+            tasks_by_status.get("pending", 0)
+        )
+
+    def _worker_signature(self, worker: Worker) -> tuple:
+        """Inputs of a worker panel; the panel is rebuilt when these change."""
+        return (
+            tuple(
+                (task_id, task.get("progress", 0), self.output_tails.get(task_id))
+                for task_id, task in worker.current_tasks.items()
+            ),
+            worker.status,
+            worker.is_active
+        )
+
+    def _update_panel(self, name: str, signature: Any, render) -> bool:
+        """
+        Rebuild a layout panel if its inputs changed since it was last built.
+
+        Args:
+            name: Layout region name
+            signature: Hashable summary of everything the panel shows
+            render: Zero-argument callable returning the new renderable
+
+        Returns:
+            True if the panel was rebuilt
+        """
+        if name in self._panel_signatures and self._panel_signatures[name] == signature:
+            return False
+
+        self._panel_signatures[name] = signature
+        self.layout[name].update(render())
+        self._dirty.add(name)
+        return True
+
+    def _redraw(self, force: bool = False) -> bool:
+        """
+        Redraw the terminal if any panel is dirty and the rate cap allows.
+
+        The minimum interval between redraws grows with the measured frame
+        time, so slow terminals (e.g. over SSH) are redrawn less often.
+
+        Args:
+            force: Redraw now regardless of the rate cap
+
+        Returns:
+            True if a frame was drawn
+        """
+        if self.live is None or not self._dirty:
+            return False
+
+        now = time.monotonic()
+        interval = max(self.min_redraw_interval, self.frame_ms / 1000 / self.render_budget)
+        if not force and now - self._last_redraw < interval:
+            return False
+
+        # A footer-only frame exists just to show the frame time; don't time
+        # it, or the footer would never settle
+        footer_only = self._dirty == {"footer"}
+
+        started = time.perf_counter()
+        self.live.refresh()
+        elapsed_ms = (time.perf_counter() - started) * 1000
+
+        self._dirty.clear()
+        self._last_redraw = now
+        self.frames_drawn += 1
+        if not footer_only:
+            self.frame_ms = elapsed_ms
+        return True
+
     def add_activity(self, source: str, event: str):
         """
         Add entry to activity log.
@@ -287,36 +396,111 @@ class TerminalStatusDisplay:
         if len(self.activity_log) > 100:
             self.activity_log = self.activity_log[-100:]
 
+        self._activity_version += 1
+
+    def _apply_status(self, status: dict) -> dict:
+        """
+        Merge a status delta into the local task and worker mirror.
+
+        Args:
+            status: Status returned by get_project_status with since
+
+        Returns:
+            Status with the full worker and task mirror attached
+        """
+        if status.get("reset"):
+            self.known_tasks = {}
+            self.known_workers = {}
+
+        self.known_tasks.update(status.get("tasks", {}))
+        self.known_workers.update(status.get("workers", {}))
+        self.status_version = status.get("version", self.status_version)
+        self.status_epoch = status.get("epoch", self.status_epoch)
+
+        return {**status, "tasks": self.known_tasks, "workers": self.known_workers}
+
+    async def _poll_output(self):
+        """Tail the live output of every running task in one batch call."""
+        running = [task_id for worker in self.workers for task_id in worker.current_tasks]
+        for task_id in list(self.output_offsets):
+            if task_id not in running:
+                self.output_offsets.pop(task_id, None)
+                self.output_tails.pop(task_id, None)
+        if not running:
+            return
+
+        results = await self.mcp_client.call_tools_batch([
+            ("get_task_output", {"task_id": task_id, "offset": self.output_offsets.get(task_id, 0)})
+            for task_id in running
+        ])
+        for task_id, entry in zip(running, results):
+            output = entry.get("result") or {}
+            if not output.get("success"):
+                continue
+            self.output_offsets[task_id] = output["next_offset"]
+            lines = [line for line in output["text"].splitlines() if line.strip()]
+            if lines:
+                self.output_tails[task_id] = lines[-1].strip()[:self.max_tail_chars]
+
+    def _sync_layout(self):
+        """Rebuild the layout if workers were added or removed since it was built."""
+        worker_ids = [w.worker_id for w in self.workers]
+        if worker_ids == self._layout_worker_ids:
+            return
+
+        self.layout = self._create_layout()
+        self._layout_worker_ids = worker_ids
+        self._panel_signatures.clear()
+        if self.live is not None:
+            self.live.update(self.layout)
+
     async def update_display(self):
         """Update the display with current status."""
+        self._sync_layout()
+
         try:
-            # Fetch current project status
-            result = await self.mcp_client.call_tool(
-                "get_project_status",
-                {}
+            # Fetch only what changed since the last refresh
+            query = {"since": self.status_version}
+            if self.status_epoch is not None:
+                query["epoch"] = self.status_epoch
+            result = await self.mcp_client.call_tool("get_project_status", query)
+
+            status = self._apply_status(result.get("status", {}))
+            await self._poll_output()
+
+            # Header (elapsed time ticks once per second)
+            elapsed = int((datetime.now() - self.start_time).total_seconds())
+            self._update_panel(
+                "header",
+                (elapsed, status.get("overall_progress", 0)),
+                lambda: self._render_header(status)
             )
 
-            status = result.get("status", {})
-
-            # Update header
-            self.layout["header"].update(self._render_header(status))
-
-            # Update worker panels
+            # Worker panels
             for i, worker in enumerate(self.workers):
-                worker_panel = self._render_worker_panel(worker, status)
-                self.layout[f"worker_{i}"].update(worker_panel)
-
-            # Update activity log
-            self.layout["activity"].update(self._render_activity())
-
-            # Update footer
-            self.layout["footer"].update(self._render_footer(status))
+                self._update_panel(
+                    f"worker_{i}",
+                    self._worker_signature(worker),
+                    lambda worker=worker: self._render_worker_panel(worker, status)
+                )
+
+            # Footer
+            self._update_panel(
+                "footer",
+                (self._footer_counts(status), round(self.frame_ms, 1)),
+                lambda: self._render_footer(status)
+            )
 
         except Exception as e:
             # Handle errors gracefully
             error_text = f"Error updating display: {str(e)}"
             self.add_activity("display", error_text)
 
+        # Activity log (also picks up errors added just above)
+        self._update_panel("activity", self._activity_version, self._render_activity)
+
+        self._redraw()
+
     async def run(self):
         """
         Run the terminal display.
@@ -324,14 +508,17 @@ class TerminalStatusDisplay:
         Continuously updates the display until project completes.
         """
         async with self.mcp_client:
-            with Live(self.layout, console=self.console, refresh_per_second=1/self.refresh_rate):
+            with Live(self.layout, console=self.console, auto_refresh=False) as live:
+                self.live = live
                 while self.project_lead.is_running:
                     await self.update_display()
                     await asyncio.sleep(self.refresh_rate)
 
                 # Final update after completion
-                await self.update_display()
                 self.add_activity("lead", "Project completed!")
+                await self.update_display()
+                self._redraw(force=True)
+                self.live = None
 
     def run_sync(self):
         """
@@ -0,0 +1,558 @@
+"""
+Post-run Log Analysis.
+
+Reads a log file and its rotated segments through their sidecar
+indexes (see log_index), parses the selected blocks in parallel worker
+processes and prints one JSON document with:
+- utilization: per-worker busy time and a timeline of running tasks,
+  from the workers' task_started / task_completed / task_failed events
+- critical_path: the chain of tasks that actually determined when the
+  project finished, from the task spans (see tracing)
+- latency: p50/p90/p99 per MCP endpoint (network I/O responses) and per
+  span name
+
+Only lines holding a wanted event type are decoded. Network I/O lines,
+usually the bulk of a log, are not decoded at all: their endpoint and
+latency are picked out of the raw bytes. Both rely on the compact
+encoding and key order JSONLogger writes.
+
+Usage:
+    python3 -m logging.analysis logs/project_activity.log
+    python3 -m logging.analysis logs/project_activity.log --report latency --since 2025-12-07T14
+    python3 -m logging.analysis logs/project_activity.log --entries --task task-005
+"""
+
+import argparse
+import os
+import re
+import sys
+from concurrent.futures import ProcessPoolExecutor
+from datetime import datetime
+from typing import Dict, List, Optional, Tuple
+
+from . import codec
+from .log_index import LogQuery, index_segment, open_segment
+from .rotation import LogRotator
+
+
+REPORTS = ("utilization", "critical_path", "latency")
+
+# Events the reports are computed from (blocks without them are skipped)
+REPORT_EVENT_TYPES = {"task_started", "task_completed", "task_failed", "span", "network_io"}
+
+# Worker events that open and close a task's busy interval
+WORKER_EVENTS = {"task_started", "task_completed", "task_failed"}
+
+# Blocks of an uncompressed file handed to one parser process at a time
+BLOCKS_PER_JOB = 8
+
+# Start of every line JSONLogger writes: timestamp and node come first
+_LINE_HEAD = re.compile(rb'\{"timestamp":"([^"\\]*)","node_type":"[^"\\]*","node_id":"([^"\\]*)"')
+
+# A network I/O response: network_io is an entry's last key and latency_ms its own
+_NETWORK_RESPONSE = re.compile(
+    rb'"direction":"response","protocol":"[^"\\\n]*","endpoint":"([^"\\\n]*)"[^\n]*"latency_ms":(-?[0-9][0-9.eE+-]*)\}\}$',
+    re.M
+)
+
+_NETWORK_MARKER = b'"event_type":"network_io"'
+
+
+def _empty_partial() -> dict:
+    """Accumulator shared by parser processes and the merge."""
+    return {
+        "lines": 0,
+        "bad_lines": 0,
+        "event_counts": {},
+        "worker_events": [],
+        "spans": [],
+        "latencies": {},
+        "entries": []
+    }
+
+
+def _marked_lines(block: bytes, markers: List[bytes]) -> List[bytes]:
+    """Lines of a block that contain any of the markers, in block order."""
+    found = {}
+    for marker in markers:
+        position = block.find(marker)
+        while position >= 0:
+            line_start = block.rfind(b"\n", 0, position) + 1
+            line_end = block.find(b"\n", position)
+            if line_end < 0:
+                line_end = len(block)
+            found[line_start] = block[line_start:line_end]
+            position = block.find(marker, line_end)
+    return [found[line_start] for line_start in sorted(found)]
+
+
+def _wanted(query: LogQuery, block: bytes, position: int) -> bool:
+    """Check the timestamp and node of the line around position against the query."""
+    if query.task_ids is not None:
+        return False
+    if query.node_ids is None and query.since is None and query.until is None:
+        return True
+    head = _LINE_HEAD.match(block, block.rfind(b"\n", 0, position) + 1)
+    if head is None:
+        return False
+    if query.node_ids is not None and head.group(2).decode("utf-8", "replace") not in query.node_ids:
+        return False
+    timestamp = head.group(1).decode("utf-8", "replace")
+    return query.in_range(timestamp, timestamp)
+
+
+def _scan_network(block: bytes, query: LogQuery, partial: dict):
+    """Count a block's network I/O lines and collect response latencies, without decoding them."""
+    filtered = query.task_ids is not None or query.node_ids is not None or query.since is not None or query.until is not None
+    if not filtered:
+        count = block.count(_NETWORK_MARKER)
+    else:
+        count = 0
+        position = block.find(_NETWORK_MARKER)
+        while position >= 0:
+            count += _wanted(query, block, position)
+            position = block.find(_NETWORK_MARKER, position + 1)
+    if count:
+        partial["event_counts"]["network_io"] = partial["event_counts"].get("network_io", 0) + count
+
+    if filtered:
+        responses = [
+            match.groups() for match in _NETWORK_RESPONSE.finditer(block)
+            if _wanted(query, block, match.start())
+        ]
+    else:
+        responses = _NETWORK_RESPONSE.findall(block)
+
+    by_endpoint: Dict[bytes, List[bytes]] = {}
+    for endpoint, latency in responses:
+        values = by_endpoint.get(endpoint)
+        if values is None:
+            values = by_endpoint[endpoint] = []
+        values.append(latency)
+    for endpoint, values in by_endpoint.items():
+        try:
+            parsed = [float(value) for value in values]
+        except ValueError:
+            continue
+        partial["latencies"].setdefault(endpoint.decode("utf-8", "replace"), []).extend(parsed)
+
+
+def _scan_entry(line: bytes, query: LogQuery, collect_entries: bool, partial: dict):
+    """Decode one line and add it to partial if it matches."""
+    try:
+        entry = codec.loads(line)
+    except codec.DecodeError:
+        partial["bad_lines"] += 1
+        return
+    if not isinstance(entry, dict) or not query.matches(entry):
+        return
+
+    kind = entry.get("event_type")
+    partial["event_counts"][kind] = partial["event_counts"].get(kind, 0) + 1
+    data = entry.get("data") if isinstance(entry.get("data"), dict) else {}
+
+    if collect_entries:
+        partial["entries"].append(entry)
+    if kind == "span":
+        partial["spans"].append(data)
+    elif kind in WORKER_EVENTS and entry.get("node_type") == "worker" and data.get("task_id"):
+        partial["worker_events"].append(
+            (entry.get("timestamp"), entry.get("node_id"), kind, data["task_id"])
+        )
+    elif kind == "network_io":
+        network_io = entry.get("network_io") or {}
+        if network_io.get("direction") == "response" and network_io.get("latency_ms") is not None:
+            partial["latencies"].setdefault(network_io.get("endpoint"), []).append(network_io["latency_ms"])
+
+
+def scan(path: str, ranges: List[Tuple[int, int]], query: LogQuery, collect_entries: bool = False) -> dict:
+    """
+    Parse byte ranges of a log file (runs in a parser process).
+
+    Args:
+        path: Log file or rotated segment
+        ranges: (offset, length) of the blocks to parse
+        query: Entries to keep
+        collect_entries: Also return the matching entries themselves
+
+    Returns:
+        Partial result (see merge)
+    """
+    partial = _empty_partial()
+
+    # Only lines holding a wanted event type are decoded (found with
+    # bytes.find); network I/O is read straight from the raw bytes unless
+    # the entries themselves are wanted.
+    event_types = query.event_types
+    fast_network = not collect_entries and (event_types is None or "network_io" in event_types)
+    markers = None
+    if event_types is not None:
+        markers = [
+            f'"event_type":"{event_type}"'.encode("utf-8")
+            for event_type in sorted(event_types)
+            if not (fast_network and event_type == "network_io")
+        ]
+
+    with open_segment(path) as data:
+        for offset, length in ranges:
+            block = data[offset:offset + length]
+            partial["lines"] += block.count(b"\n") + (0 if block.endswith(b"\n") else 1)
+
+            if fast_network:
+                _scan_network(block, query, partial)
+            if markers is not None:
+                lines = _marked_lines(block, markers)
+            else:
+                lines = [
+                    line for line in block.split(b"\n")
+                    if line and not (fast_network and _NETWORK_MARKER in line)
+                ]
+            for line in lines:
+                _scan_entry(line, query, collect_entries, partial)
+    return partial
+
+
+def merge(partials: List[dict]) -> dict:
+    """Combine the partial results of several scans."""
+    total = _empty_partial()
+    for partial in partials:
+        total["lines"] += partial["lines"]
+        total["bad_lines"] += partial["bad_lines"]
+        for kind, count in partial["event_counts"].items():
+            total["event_counts"][kind] = total["event_counts"].get(kind, 0) + count
+        total["worker_events"].extend(partial["worker_events"])
+        total["spans"].extend(partial["spans"])
+        for endpoint, values in partial["latencies"].items():
+            total["latencies"].setdefault(endpoint, []).extend(values)
+        total["entries"].extend(partial["entries"])
+    return total
+
+
+def log_files(path: str) -> List[str]:
+    """Rotated segments of a log, oldest first, followed by the active file."""
+    if not os.path.isdir(os.path.dirname(os.path.abspath(path))):
+        return []
+    files = LogRotator(path, strategy="none").segments()
+    if os.path.exists(path):
+        files.append(path)
+    return files
+
+
+def plan_jobs(path: str, query: LogQuery, rebuild_index: bool = False) -> Tuple[List[tuple], dict]:
+    """
+    Select the blocks to parse across a log's files.
+
+    Sidecar indexes are built if missing, and the active file's is
+    extended over what was logged since the last analysis.
+
+    Args:
+        path: Active log file
+        query: Entries wanted
+        rebuild_index: Rebuild every sidecar index
+
+    Returns:
+        ([(file, ranges), ...], per-file selection stats)
+    """
+    jobs = []
+    stats = {"files": 0, "blocks": 0, "blocks_selected": 0, "bytes": 0, "bytes_selected": 0}
+    for file in log_files(path):
+        index = index_segment(file, rebuild=rebuild_index)
+        selected = query.blocks(index)
+        blocks = index["blocks"]
+
+        stats["files"] += 1
+        stats["blocks"] += len(blocks)
+        stats["blocks_selected"] += len(selected)
+        stats["bytes"] += index["bytes"]
+        stats["bytes_selected"] += sum(blocks[number][1] for number in selected)
+
+        ranges = [(blocks[number][0], blocks[number][1]) for number in selected]
+        if not ranges:
+            continue
+        # A compressed segment is decompressed once, so it stays one job
+        step = len(ranges) if file.endswith((".gz", ".zst")) else BLOCKS_PER_JOB
+        for start in range(0, len(ranges), step):
+            jobs.append((file, ranges[start:start + step]))
+    return jobs, stats
+
+
+def _epoch(timestamp: str) -> float:
+    """Unix time of a log timestamp (ISO 8601, UTC, trailing Z)."""
+    return (datetime.fromisoformat(timestamp.rstrip("Z")) - datetime(1970, 1, 1)).total_seconds()
+
+
+def _iso(seconds: float) -> str:
+    """Log timestamp of a Unix time."""
+    return datetime.utcfromtimestamp(seconds).isoformat() + "Z"
+
+
+def _percentile(values: List[float], q: float) -> Optional[float]:
+    """Nearest-rank percentile of sorted values."""
+    if not values:
+        return None
+    return round(values[min(len(values) - 1, max(0, int(round(q * len(values))) - 1))], 3)
+
+
+def _summary(values: List[float]) -> dict:
+    """Count and percentiles of a latency sample (milliseconds)."""
+    values = sorted(values)
+    return {
+        "count": len(values),
+        "p50_ms": _percentile(values, 0.50),
+        "p90_ms": _percentile(values, 0.90),
+        "p99_ms": _percentile(values, 0.99),
+        "max_ms": round(values[-1], 3) if values else None
+    }
+
+
+def utilization_report(worker_events: List[tuple], buckets: int = 20) -> dict:
+    """
+    Worker busy time and a timeline of how many tasks were running.
+
+    A task runs on a worker from its task_started event until its
+    task_completed or task_failed event; tasks still open at the end of
+    the log count until the last event. A worker is busy while it runs
+    at least one task (workers with several slots overlap tasks).
+
+    Args:
+        worker_events: (timestamp, worker id, event type, task id)
+        buckets: Timeline resolution
+
+    Returns:
+        {"start", "end", "workers": {id: {"tasks", "busy_seconds", "utilization"}},
+        "timeline": [{"start", "running_tasks"}, ...]}
+    """
+    events = sorted((_epoch(ts), node, kind, task) for ts, node, kind, task in worker_events if ts)
+    if not events:
+        return {"start": None, "end": None, "workers": {}, "timeline": []}
+
+    first, last = events[0][0], events[-1][0]
+    open_tasks: Dict[tuple, float] = {}
+    intervals: Dict[str, List[tuple]] = {node: [] for _at, node, _kind, _task in events}
+    for at, node, kind, task in events:
+        if kind == "task_started":
+            open_tasks[(node, task)] = at
+        elif (node, task) in open_tasks:
+            intervals[node].append((open_tasks.pop((node, task)), at))
+    for (node, _task), started in open_tasks.items():
+        intervals[node].append((started, last))
+
+    window = max(last - first, 1e-9)
+    width = window / max(1, buckets)
+    running = [0.0] * max(1, buckets)
+    workers = {}
+    for node, spans in sorted(intervals.items()):
+        busy = 0.0
+        busy_until = first
+        for started, ended in sorted(spans):
+            busy += max(0.0, ended - max(started, busy_until))
+            busy_until = max(busy_until, ended)
+            for bucket in range(int((started - first) / width), min(len(running), int((ended - first) / width) + 1)):
+                low = first + bucket * width
+                overlap = min(ended, low + width) - max(started, low)
+                if overlap > 0:
+                    running[bucket] += overlap / width
+        workers[node] = {
+            "tasks": len(spans),
+            "busy_seconds": round(busy, 3),
+            "utilization": round(busy / window, 3)
+        }
+
+    return {
+        "start": _iso(first),
+        "end": _iso(last),
+        "workers": workers,
+        "timeline": [
+            {"start": _iso(first + bucket * width), "running_tasks": round(value, 2)}
+            for bucket, value in enumerate(running)
+        ]
+    }
+
+
+def critical_path_report(spans: List[dict]) -> dict:
+    """
+    The chain of tasks that actually determined the project's end.
+
+    Starting from the task that finished last, each step goes to the
+    dependency that finished last (the one that unblocked it). Each task
+    is broken down into the time it was blocked, queued and leased.
+
+    Args:
+        spans: Span data from "span" events
+
+    Returns:
+        {"seconds", "tasks": [{"task_id", "start", "end", "blocked_ms",
+        "queued_ms", "leased_ms", "execute_ms", "worker_id"}, ...]}
+    """
+    tasks: Dict[str, dict] = {}
+    phases: Dict[str, dict] = {}
+    for span in spans:
+        task_id = span.get("task_id")
+        if not task_id or "start" not in span:
+            continue
+        name = span.get("name")
+        end = span["start"] + span.get("duration_ms", 0) / 1000
+        if name == "task":
+            # A retried task is recorded again; its last finish counts
+            if task_id not in tasks or end >= tasks[task_id]["end"]:
+                tasks[task_id] = {
+                    "start": span["start"],
+                    "end": end,
+                    "dependencies": span.get("dependencies") or [],
+                    "status": span.get("status")
+                }
+        elif name in ("task.blocked", "task.queued", "task.leased", "task.execute"):
+            phase = phases.setdefault(task_id, {})
+            key = f"{name.split('.', 1)[1]}_ms"
+            phase[key] = round(phase.get(key, 0.0) + span.get("duration_ms", 0), 3)
+            if span.get("worker_id"):
+                phase["worker_id"] = span["worker_id"]
+
+    if not tasks:
+        return {"seconds": None, "tasks": []}
+
+    chain = []
+    current = max(tasks, key=lambda task_id: tasks[task_id]["end"])
+    seen = set()
+    while current is not None and current not in seen:
+        seen.add(current)
+        chain.append(current)
+        dependencies = [dep for dep in tasks[current]["dependencies"] if dep in tasks]
+        current = max(dependencies, key=lambda dep: tasks[dep]["end"]) if dependencies else None
+    chain.reverse()
+
+    return {
+        "seconds": round(tasks[chain[-1]]["end"] - tasks[chain[0]]["start"], 3),
+        "tasks": [
+            {
+                "task_id": task_id,
+                "start": _iso(tasks[task_id]["start"]),
+                "end": _iso(tasks[task_id]["end"]),
+                "status": tasks[task_id]["status"],
+                **phases.get(task_id, {})
+            }
+            for task_id in chain
+        ]
+    }
+
+
+def latency_report(latencies: Dict[str, List[float]], spans: List[dict]) -> dict:
+    """
+    Latency percentiles per endpoint and per span name.
+
+    Args:
+        latencies: Response latencies (ms) by endpoint
+        spans: Span data from "span" events
+
+    Returns:
+        {"endpoints": {endpoint: summary}, "spans": {name: summary}}
+    """
+    by_name: Dict[str, List[float]] = {}
+    for span in spans:
+        if span.get("name") and span.get("duration_ms") is not None:
+            by_name.setdefault(span["name"], []).append(span["duration_ms"])
+    return {
+        "endpoints": {endpoint: _summary(values) for endpoint, values in sorted(latencies.items())},
+        "spans": {name: _summary(values) for name, values in sorted(by_name.items())}
+    }
+
+
+def analyze(
+    path: str,
+    query: Optional[LogQuery] = None,
+    reports: Tuple[str, ...] = REPORTS,
+    collect_entries: bool = False,
+    jobs: Optional[int] = None,
+    buckets: int = 20,
+    rebuild_index: bool = False
+) -> dict:
+    """
+    Analyze a log and its rotated segments.
+
+    Args:
+        path: Active log file
+        query: Entries to consider (everything if omitted)
+        reports: Reports to produce (see REPORTS)
+        collect_entries: Include the matching entries in the result
+        jobs: Parser processes (CPU count if omitted; 1 parses inline)
+        buckets: Utilization timeline resolution
+        rebuild_index: Rebuild every sidecar index
+
+    Returns:
+        {"index", "lines", "bad_lines", "event_counts", <reports>, ["entries"]}
+    """
+    query = query or LogQuery()
+    scan_query = query
+    if query.event_types is None and not collect_entries:
+        # Reports only read a few event types; skip blocks without them
+        scan_query = LogQuery(REPORT_EVENT_TYPES, query.node_ids, query.task_ids, query.since, query.until)
+
+    planned, stats = plan_jobs(path, scan_query, rebuild_index)
+    jobs = jobs or os.cpu_count() or 1
+    if jobs == 1 or len(planned) <= 1:
+        partials = [scan(file, ranges, scan_query, collect_entries) for file, ranges in planned]
+    else:
+        with ProcessPoolExecutor(max_workers=min(jobs, len(planned))) as pool:
+            partials = list(pool.map(
+                scan,
+                [file for file, _ in planned],
+                [ranges for _, ranges in planned],
+                [scan_query] * len(planned),
+                [collect_entries] * len(planned)
+            ))
+    total = merge(partials)
+
+    result = {
+        "index": stats,
+        "lines": total["lines"],
+        "bad_lines": total["bad_lines"],
+        "event_counts": dict(sorted(total["event_counts"].items()))
+    }
+    if "utilization" in reports:
+        result["utilization"] = utilization_report(total["worker_events"], buckets)
+    if "critical_path" in reports:
+        result["critical_path"] = critical_path_report(total["spans"])
+    if "latency" in reports:
+        result["latency"] = latency_report(total["latencies"], total["spans"])
+    if collect_entries:
+        result["entries"] = sorted(total["entries"], key=lambda entry: entry.get("timestamp") or "")
+    return result
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(
+        prog="python3 -m logging.analysis",
+        description="Summarize a project activity log and its rotated segments"
+    )
+    parser.add_argument("log", nargs="?", default="logs/project_activity.log", help="Active log file")
+    parser.add_argument("--report", choices=REPORTS, nargs="+", default=list(REPORTS), help="Reports to produce")
+    parser.add_argument("--event-type", nargs="+", help="Only these event types")
+    parser.add_argument("--node", nargs="+", help="Only these node ids")
+    parser.add_argument("--task", nargs="+", help="Only entries about these task ids")
+    parser.add_argument("--since", help="Earliest timestamp (ISO 8601, prefixes allowed)")
+    parser.add_argument("--until", help="Latest timestamp (inclusive, prefixes allowed)")
+    parser.add_argument("--entries", action="store_true", help="Also print the matching entries")
+    parser.add_argument("--jobs", type=int, help="Parser processes (default: CPU count)")
+    parser.add_argument("--buckets", type=int, default=20, help="Utilization timeline buckets")
+    parser.add_argument("--reindex", action="store_true", help="Rebuild the segments' sidecar indexes")
+    args = parser.parse_args(argv)
+
+    if not log_files(args.log):
+        print(f"Error: No log files found for {args.log}")
+        sys.exit(1)
+
+    query = LogQuery(args.event_type, args.node, args.task, args.since, args.until)
+    result = analyze(
+        args.log,
+        query,
+        tuple(args.report),
+        collect_entries=args.entries,
+        jobs=args.jobs,
+        buckets=args.buckets,
+        rebuild_index=args.reindex
+    )
+    print(codec.dumps(result))
+
+
+if __name__ == "__main__":
+    main()
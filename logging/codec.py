@@ -0,0 +1,156 @@
+"""
+JSON Codec for the Autonomous Development Team.
+
+One compact JSON encoder/decoder shared by the MCP server, MCP client,
+context store journal and logger. Uses orjson or msgspec when installed,
+falling back to the standard library. The MCP_JSON_CODEC environment
+variable or set_codec() selects one explicitly.
+"""
+
+import json
+import os
+from typing import Any, Callable, Dict, Optional, Union
+
+
+class DecodeError(ValueError):
+    """Raised by loads() for malformed input, whichever codec is active."""
+    pass
+
+
+class JSONCodec:
+    """Standard library codec (always available)."""
+
+    name = "json"
+
+    def dumps(self, obj: Any, default: Optional[Callable[[Any], Any]] = None) -> str:
+        """Encode compactly to str."""
+        return json.dumps(obj, separators=(',', ':'), default=default)
+
+    def dumps_bytes(self, obj: Any, default: Optional[Callable[[Any], Any]] = None) -> bytes:
+        """Encode compactly to UTF-8 bytes."""
+        return self.dumps(obj, default).encode("utf-8")
+
+    def loads(self, data: Union[str, bytes]) -> Any:
+        """Decode str or bytes."""
+        try:
+            return json.loads(data)
+        except json.JSONDecodeError as e:
+            raise DecodeError(str(e)) from e
+
+
+class OrjsonCodec(JSONCodec):
+    """orjson codec; non-string dict keys are stringified like the standard library does."""
+
+    name = "orjson"
+
+    def __init__(self):
+        import orjson
+        self._orjson = orjson
+        self._option = orjson.OPT_NON_STR_KEYS
+
+    def dumps(self, obj: Any, default: Optional[Callable[[Any], Any]] = None) -> str:
+        return self.dumps_bytes(obj, default).decode("utf-8")
+
+    def dumps_bytes(self, obj: Any, default: Optional[Callable[[Any], Any]] = None) -> bytes:
+        return self._orjson.dumps(obj, default=default, option=self._option)
+
+    def loads(self, data: Union[str, bytes]) -> Any:
+        try:
+            return self._orjson.loads(data)
+        except self._orjson.JSONDecodeError as e:
+            raise DecodeError(str(e)) from e
+
+
+class MsgspecCodec(JSONCodec):
+    """msgspec codec."""
+
+    name = "msgspec"
+
+    def __init__(self):
+        import msgspec
+        self._msgspec = msgspec
+        self._encoder = msgspec.json.Encoder()
+        self._decoder = msgspec.json.Decoder()
+        self._default_encoders: Dict[Callable, Any] = {}
+
+    def dumps(self, obj: Any, default: Optional[Callable[[Any], Any]] = None) -> str:
+        return self.dumps_bytes(obj, default).decode("utf-8")
+
+    def dumps_bytes(self, obj: Any, default: Optional[Callable[[Any], Any]] = None) -> bytes:
+        if default is None:
+            return self._encoder.encode(obj)
+        encoder = self._default_encoders.get(default)
+        if encoder is None:
+            encoder = self._msgspec.json.Encoder(enc_hook=default)
+            self._default_encoders[default] = encoder
+        return encoder.encode(obj)
+
+    def loads(self, data: Union[str, bytes]) -> Any:
+        try:
+            return self._decoder.decode(data)
+        except self._msgspec.DecodeError as e:
+            raise DecodeError(str(e)) from e
+
+
+# Preference order when no codec is requested
+CODECS = {
+    "orjson": OrjsonCodec,
+    "msgspec": MsgspecCodec,
+    "json": JSONCodec
+}
+
+_active: JSONCodec = JSONCodec()
+
+
+def set_codec(name: str = "auto") -> str:
+    """
+    Select the process-wide codec.
+
+    Args:
+        name: orjson, msgspec, json, or auto for the fastest installed one
+
+    Returns:
+        Name of the codec now in use
+
+    Raises:
+        ValueError: If the name is unknown
+        ImportError: If the named codec's package is not installed
+    """
+    global _active
+
+    if name == "auto":
+        for codec_class in CODECS.values():
+            try:
+                _active = codec_class()
+                break
+            except ImportError:
+                continue
+    elif name in CODECS:
+        _active = CODECS[name]()
+    else:
+        raise ValueError(f"Unknown JSON codec: {name}")
+
+    return _active.name
+
+
+def get_codec() -> JSONCodec:
+    """The codec currently in use."""
+    return _active
+
+
+def dumps(obj: Any, default: Optional[Callable[[Any], Any]] = None) -> str:
+    """Encode compactly to str with the active codec."""
+    return _active.dumps(obj, default)
+
+
+def dumps_bytes(obj: Any, default: Optional[Callable[[Any], Any]] = None) -> bytes:
+    """Encode compactly to UTF-8 bytes with the active codec."""
+    return _active.dumps_bytes(obj, default)
+
+
+def loads(data: Union[str, bytes]) -> Any:
+    """Decode str or bytes with the active codec."""
+    return _active.loads(data)
+
+
+set_codec(os.environ.get("MCP_JSON_CODEC", "auto"))
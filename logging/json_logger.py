@@ -8,15 +8,23 @@ Provides structured logging with NDJSON format for all node types:
 - Display
 
 Includes network I/O logging and sensitive data sanitization.
+File writes are handed to a background LogWriter so logging never
+blocks the event loop on disk I/O.
 """
 
-import json
+import asyncio
 import os
+import re
 import uuid
 from datetime import datetime
 from typing import Any, Optional, Dict
 from pathlib import Path
 
+from . import codec
+from .log_writer import get_log_writer
+from .network_policy import NetworkLogPolicy
+from .tracing import current_span
+
 
 class JSONLogger:
     """
@@ -28,7 +36,8 @@ class JSONLogger:
     - node_id: Unique identifier for the node
     - event_type: Type of event being logged
     - level: DEBUG, INFO, WARNING, ERROR, CRITICAL
-    - correlation_id: UUID for tracking request flow
+    - correlation_id: Trace id of the current span (see tracing), else a UUID
+    - span_id: Current span, when one is active
     - data: Event-specific payload
     - network_io: Optional network I/O details
     """
@@ -42,18 +51,29 @@ class JSONLogger:
         "task_progress",
         "task_completed",
         "task_failed",
+        "task_retried",
         "network_io",
         "clarification_request",
         "escalation",
         "system_error",
         "worker_started",
         "worker_stopped",
+        "worker_draining",
+        "worker_scaled",
+        "schedule_report",
         "server_started",
-        "server_stopped"
+        "server_stopped",
+        "span"
     }
     VALID_LEVELS = {"DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"}
 
-    def __init__(self, node_type: str, node_id: str, log_file: str = "logs/project_activity.log"):
+    def __init__(
+        self,
+        node_type: str,
+        node_id: str,
+        log_file: str = "logs/project_activity.log",
+        network_policy: Optional[NetworkLogPolicy] = None
+    ):
         """
         Initialize the JSON logger.
 
@@ -61,6 +81,7 @@ class JSONLogger:
             node_type: Type of node (project_lead, worker, mcp_server, display)
             node_id: Unique identifier for this node instance
             log_file: Path to the log file (default: logs/project_activity.log)
+            network_policy: Sampling/truncation policy for network I/O entries
 
         Raises:
             ValueError: If node_type is invalid
@@ -71,19 +92,24 @@ class JSONLogger:
         self.node_type = node_type
         self.node_id = node_id
         self.log_file = log_file
+        self.network_policy = network_policy or NetworkLogPolicy()
 
         # Ensure log directory exists
         log_dir = os.path.dirname(log_file)
         if log_dir:
             Path(log_dir).mkdir(parents=True, exist_ok=True)
 
+        # Shared background writer for this file
+        self.writer = get_log_writer(log_file)
+
     def _create_log_entry(
         self,
         event_type: str,
         data: dict,
         network_io: Optional[dict] = None,
         level: str = "INFO",
-        correlation_id: Optional[str] = None
+        correlation_id: Optional[str] = None,
+        sanitized: bool = False
     ) -> dict:
         """
         Create a structured log entry.
@@ -94,6 +120,7 @@ class JSONLogger:
             network_io: Optional network I/O details
             level: Log level (DEBUG, INFO, WARNING, ERROR, CRITICAL)
             correlation_id: Optional correlation ID for tracking requests
+            sanitized: Data is known to hold no sensitive fields; skip sanitizing
 
         Returns:
             Dictionary representing the log entry
@@ -101,8 +128,9 @@ class JSONLogger:
         if level not in self.VALID_LEVELS:
             level = "INFO"
 
+        span = current_span()
         if correlation_id is None:
-            correlation_id = str(uuid.uuid4())
+            correlation_id = span[0] if span else str(uuid.uuid4())
 
         entry = {
             "timestamp": datetime.utcnow().isoformat() + "Z",
@@ -111,9 +139,12 @@ class JSONLogger:
             "event_type": event_type,
             "level": level,
             "correlation_id": correlation_id,
-            "data": self._sanitize_data(data)
+            "data": data if sanitized else self._sanitize_data(data)
         }
 
+        if span is not None and span[0] == correlation_id:
+            entry["span_id"] = span[1]
+
         if network_io:
             entry["network_io"] = network_io
 
@@ -125,7 +156,8 @@ class JSONLogger:
         data: dict,
         network_io: Optional[dict] = None,
         level: str = "INFO",
-        correlation_id: Optional[str] = None
+        correlation_id: Optional[str] = None,
+        sanitized: bool = False
     ):
         """
         Log an event asynchronously.
@@ -136,13 +168,12 @@ class JSONLogger:
             network_io: Optional network I/O details
             level: Log level
             correlation_id: Optional correlation ID
+            sanitized: Data is known to hold no sensitive fields
         """
-        entry = self._create_log_entry(event_type, data, network_io, level, correlation_id)
+        entry = self._create_log_entry(event_type, data, network_io, level, correlation_id, sanitized)
 
-        # Write as NDJSON (newline-delimited JSON)
-        with open(self.log_file, "a") as f:
-            f.write(json.dumps(entry, separators=(',', ':')) + "\n")
-            f.flush()  # Ensure immediate write
+        # Queue as NDJSON (newline-delimited JSON) for the background writer
+        await self.writer.write_async(codec.dumps(entry))
 
     def log_sync(
         self,
@@ -150,23 +181,30 @@ class JSONLogger:
         data: dict,
         network_io: Optional[dict] = None,
         level: str = "INFO",
-        correlation_id: Optional[str] = None
+        correlation_id: Optional[str] = None,
+        sanitized: bool = False
     ):
         """
         Log an event synchronously (for non-async contexts).
 
+        On an event loop thread this never waits for queue space (the
+        caller may hold a lock): a full queue drops the entry instead.
+
         Args:
             event_type: Type of event
             data: Event-specific data
             network_io: Optional network I/O details
             level: Log level
             correlation_id: Optional correlation ID
+            sanitized: Data is known to hold no sensitive fields
         """
-        entry = self._create_log_entry(event_type, data, network_io, level, correlation_id)
+        entry = self._create_log_entry(event_type, data, network_io, level, correlation_id, sanitized)
+
+        self.writer.write(codec.dumps(entry))
 
-        with open(self.log_file, "a") as f:
-            f.write(json.dumps(entry, separators=(',', ':')) + "\n")
-            f.flush()
+    async def flush(self):
+        """Wait until every entry logged so far has been written to disk."""
+        await asyncio.get_running_loop().run_in_executor(None, self.writer.flush)
 
     async def log_network_io(
         self,
@@ -177,11 +215,17 @@ class JSONLogger:
         status_code: Optional[int] = None,
         latency_ms: Optional[float] = None,
         headers: Optional[dict] = None,
-        correlation_id: Optional[str] = None
+        correlation_id: Optional[str] = None,
+        sanitized: bool = False
     ):
         """
         Log network I/O activity.
 
+        The entry is shaped by network_policy: bodies are truncated to a
+        fingerprint when oversized, and in latency_only mode only the
+        response line is kept, without body or headers. Sampling is
+        decided by the caller once per call via network_policy.should_log.
+
         Args:
             direction: "request" or "response"
             protocol: Protocol used (e.g., "mcp", "http", "postgresql")
@@ -191,25 +235,45 @@ class JSONLogger:
             latency_ms: Latency in milliseconds
             headers: Optional headers
             correlation_id: Optional correlation ID
+            sanitized: Body is known to hold no sensitive fields
         """
-        network_io = {
-            "direction": direction,
-            "protocol": protocol,
-            "endpoint": endpoint,
-            "body": self._sanitize_data(body) if isinstance(body, dict) else body,
-            "status_code": status_code,
-            "latency_ms": latency_ms
-        }
-
-        if headers:
-            network_io["headers"] = self._sanitize_data(headers)
+        policy = self.network_policy
+
+        if policy.mode == "off":
+            return
+
+        if policy.mode == "latency_only":
+            if direction == "request":
+                return
+            network_io = {
+                "direction": direction,
+                "protocol": protocol,
+                "endpoint": endpoint,
+                "status_code": status_code,
+                "latency_ms": latency_ms
+            }
+        else:
+            network_io = {
+                "direction": direction,
+                "protocol": protocol,
+                "endpoint": endpoint,
+                "body": policy.prepare_body(
+                    self._sanitize_data(body) if isinstance(body, dict) and not sanitized else body
+                ),
+                "status_code": status_code,
+                "latency_ms": latency_ms
+            }
+
+            if headers and policy.include_headers:
+                network_io["headers"] = self._sanitize_data(headers)
 
         await self.log(
             "network_io",
             {},
             network_io=network_io,
             level="DEBUG",
-            correlation_id=correlation_id
+            correlation_id=correlation_id,
+            sanitized=True
         )
 
     def _sanitize_data(self, data: Any) -> Any:
@@ -224,32 +288,93 @@ class JSONLogger:
         Returns:
             Sanitized data
         """
-        sensitive_keys = {
-            "password",
-            "api_key",
-            "secret",
-            "token",
-            "authorization",
-            "auth",
-            "credential",
-            "access_token",
-            "refresh_token",
-            "private_key",
-            "jwt"
-        }
+        return sanitize(data)
+
+
+# Substrings that mark a key as sensitive (matched case-insensitively)
+SENSITIVE_KEYS = (
+    "password",
+    "api_key",
+    "secret",
+    "token",
+    "authorization",
+    "auth",
+    "credential",
+    "access_token",
+    "refresh_token",
+    "private_key",
+    "jwt"
+)
 
-        def _sanitize(obj):
-            if isinstance(obj, dict):
-                return {
-                    k: "***REDACTED***" if any(sens in k.lower() for sens in sensitive_keys)
-                    else _sanitize(v)
-                    for k, v in obj.items()
-                }
-            elif isinstance(obj, list):
-                return [_sanitize(item) for item in obj]
-            return obj
+_SENSITIVE_KEY_PATTERN = re.compile("|".join(re.escape(key) for key in SENSITIVE_KEYS))
 
-        return _sanitize(data)
+# Per-key verdicts; payload keys repeat heavily, so this stays small
+_sensitive_key_cache: Dict[Any, bool] = {}
+_SENSITIVE_KEY_CACHE_LIMIT = 4096
+
+REDACTED = "***REDACTED***"
+
+
+def _is_sensitive_key(key: Any) -> bool:
+    """
+    Check whether a dictionary key names sensitive data.
+
+    Args:
+        key: Dictionary key
+
+    Returns:
+        True if the key contains a sensitive substring
+    """
+    verdict = _sensitive_key_cache.get(key)
+    if verdict is None:
+        verdict = _SENSITIVE_KEY_PATTERN.search(str(key).lower()) is not None
+        if len(_sensitive_key_cache) >= _SENSITIVE_KEY_CACHE_LIMIT:
+            _sensitive_key_cache.clear()
+        _sensitive_key_cache[key] = verdict
+    return verdict
+
+
+def sanitize(data: Any) -> Any:
+    """
+    Redact sensitive fields in nested dicts and lists.
+
+    Containers with nothing to redact are returned as-is rather than
+    copied, so clean payloads cost one pass and no allocation.
+
+    Args:
+        data: Data to sanitize
+
+    Returns:
+        Sanitized data
+    """
+    if isinstance(data, dict):
+        result = None
+        for k, v in data.items():
+            if _is_sensitive_key(k):
+                clean = REDACTED
+            elif isinstance(v, (dict, list)):
+                clean = sanitize(v)
+            else:
+                continue
+
+            if clean is not v:
+                if result is None:
+                    result = dict(data)
+                result[k] = clean
+        return data if result is None else result
+
+    if isinstance(data, list):
+        result = None
+        for i, item in enumerate(data):
+            if isinstance(item, (dict, list)):
+                clean = sanitize(item)
+                if clean is not item:
+                    if result is None:
+                        result = list(data)
+                    result[i] = clean
+        return data if result is None else result
+
+    return data
 
 
 def sanitize_log_data(data: dict) -> dict:
@@ -262,5 +387,4 @@ def sanitize_log_data(data: dict) -> dict:
     Returns:
         Sanitized data
     """
-    logger = JSONLogger("system", "sanitizer")
-    return logger._sanitize_data(data)
+    return sanitize(data)
@@ -0,0 +1,344 @@
+"""
+Sidecar Indexes for NDJSON Log Segments.
+
+A log file is cut into blocks of about BLOCK_BYTES, always ending on a
+line boundary. Its index records each block's byte range, line count
+and time range, plus posting lists from event_type, node_id and
+task_id values to the blocks that contain them. Readers use it to map
+only the blocks a query can match and to hand blocks to parallel
+parsers independently.
+
+Indexes are built with regular expressions over raw block bytes (no
+JSON parsing), so they may list a block for a value it only mentions
+in a payload: posting lists are a superset, and readers still check
+every entry they parse. Offsets always refer to the uncompressed
+segment, so an index written before a segment is compressed stays
+valid for it. The active log file keeps a sidecar as well; when the
+file has grown since, only its tail is indexed.
+"""
+
+import contextlib
+import gzip
+import hashlib
+import mmap
+import os
+import re
+from typing import Iterable, Iterator, List, Optional, Union
+
+from . import codec
+
+try:
+    import zstandard
+except ImportError:  # Optional dependency; only needed for .zst segments
+    zstandard = None
+
+
+# Bump when the index layout changes; older indexes are rebuilt
+INDEX_VERSION = 1
+
+# Sidecar suffix, appended to the uncompressed segment name
+INDEX_SUFFIX = ".idx"
+
+# Target block size; blocks end at the first newline past it
+BLOCK_BYTES = 1024 * 1024
+
+# Leading bytes fingerprinted to tell a grown file from a replaced one
+HEAD_BYTES = 4096
+
+# Compressed segment suffixes, as written by LogRotator
+COMPRESSED_SUFFIXES = (".gz", ".zst")
+
+_TIMESTAMP = re.compile(rb'"timestamp":\s*"([^"\\]*)"')
+_POSTINGS = {
+    "event_types": re.compile(rb'"event_type":\s*"([^"\\]*)"'),
+    "node_ids": re.compile(rb'"node_id":\s*"([^"\\]*)"'),
+    "task_ids": re.compile(rb'"task_id":\s*"([^"\\]*)"')
+}
+
+
+def index_path(segment: str) -> str:
+    """Sidecar index path of a segment (compressed or not)."""
+    for suffix in COMPRESSED_SUFFIXES:
+        if segment.endswith(suffix):
+            segment = segment[:-len(suffix)]
+            break
+    return f"{segment}{INDEX_SUFFIX}"
+
+
+@contextlib.contextmanager
+def open_segment(path: str) -> Iterator[Union[bytes, mmap.mmap]]:
+    """
+    Open a log file for random access.
+
+    Uncompressed files are memory-mapped; compressed segments are
+    decompressed into memory.
+
+    Args:
+        path: Log file or rotated segment
+
+    Yields:
+        The file's (uncompressed) contents
+
+    Raises:
+        RuntimeError: If the segment is zstd-compressed and zstandard isn't installed
+    """
+    if path.endswith(".gz"):
+        with gzip.open(path, "rb") as f:
+            yield f.read()
+        return
+
+    if path.endswith(".zst"):
+        if zstandard is None:
+            raise RuntimeError(f"Reading {path} requires the zstandard package")
+        with open(path, "rb") as f:
+            yield zstandard.ZstdDecompressor().stream_reader(f).read()
+        return
+
+    with open(path, "rb") as f:
+        if os.fstat(f.fileno()).st_size == 0:
+            yield b""
+            return
+        data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        try:
+            yield data
+        finally:
+            data.close()
+
+
+def _block_ranges(data: Union[bytes, mmap.mmap], block_bytes: int, offset: int = 0) -> Iterator[tuple]:
+    """(offset, length) of each block from offset on, ending on line boundaries."""
+    size = len(data)
+    while offset < size:
+        end = data.find(b"\n", min(offset + block_bytes, size) - 1)
+        end = size if end < 0 else end + 1
+        yield offset, end - offset
+        offset = end
+
+
+def _head(data: Union[bytes, mmap.mmap], length: int) -> str:
+    """Fingerprint of a file's first length bytes."""
+    return hashlib.sha256(data[:length]).hexdigest()
+
+
+def build_index(
+    data: Union[bytes, mmap.mmap],
+    source: str,
+    block_bytes: int = BLOCK_BYTES,
+    base: Optional[dict] = None
+) -> dict:
+    """
+    Index a log file's contents.
+
+    Args:
+        data: Uncompressed contents
+        source: Name of the indexed file (recorded to detect mismatched sidecars)
+        block_bytes: Target block size
+        base: Index of an earlier, shorter version of the same file; its
+            blocks are kept and only the rest is indexed (from its last
+            block on, which may have ended mid-line)
+
+    Returns:
+        Index: {"version", "source", "bytes", "head_bytes", "head", "lines",
+        "start", "end", "blocks": [[offset, length, lines, start, end], ...],
+        "event_types" / "node_ids" / "task_ids": {value: [block, ...]}}
+    """
+    head_bytes = min(len(data), HEAD_BYTES)
+    index = {
+        "version": INDEX_VERSION,
+        "source": source,
+        "bytes": len(data),
+        "head_bytes": head_bytes,
+        "head": _head(data, head_bytes),
+        "lines": 0,
+        "start": None,
+        "end": None,
+        "blocks": [],
+        **{field: {} for field in _POSTINGS}
+    }
+
+    first, start_offset = 0, 0
+    if base is not None and base["blocks"]:
+        first = len(base["blocks"]) - 1
+        start_offset = base["blocks"][first][0]
+        index["blocks"] = base["blocks"][:first]
+        for field in _POSTINGS:
+            for value, blocks in base[field].items():
+                kept = blocks[:-1] if blocks and blocks[-1] == first else blocks
+                if kept:
+                    index[field][value] = kept
+        for _offset, _length, lines, start, end in index["blocks"]:
+            index["lines"] += lines
+            if start is not None:
+                index["start"] = start if index["start"] is None else min(index["start"], start)
+                index["end"] = end if index["end"] is None else max(index["end"], end)
+
+    for number, (offset, length) in enumerate(_block_ranges(data, block_bytes, start_offset), first):
+        block = data[offset:offset + length]
+        lines = block.count(b"\n") + (0 if block.endswith(b"\n") else 1)
+        timestamps = _TIMESTAMP.findall(block)
+        start = min(timestamps).decode("utf-8", "replace") if timestamps else None
+        end = max(timestamps).decode("utf-8", "replace") if timestamps else None
+
+        index["blocks"].append([offset, length, lines, start, end])
+        index["lines"] += lines
+        if start is not None:
+            index["start"] = start if index["start"] is None else min(index["start"], start)
+            index["end"] = end if index["end"] is None else max(index["end"], end)
+
+        for field, pattern in _POSTINGS.items():
+            postings = index[field]
+            for value in set(pattern.findall(block)):
+                postings.setdefault(value.decode("utf-8", "replace"), []).append(number)
+
+    return index
+
+
+def load_index(segment: str) -> Optional[dict]:
+    """
+    Read a segment's sidecar index.
+
+    Returns:
+        Index, or None if there is none or it is unreadable, outdated or
+        belongs to another file (it may describe an earlier, shorter
+        version of the file)
+    """
+    path = index_path(segment)
+    try:
+        with open(path, "rb") as f:
+            index = codec.loads(f.read())
+    except FileNotFoundError:
+        return None
+    except (codec.DecodeError, IOError) as e:
+        print(f"Warning: Ignoring unreadable log index {path}: {e}")
+        return None
+
+    if index.get("version") != INDEX_VERSION or index.get("source") != os.path.basename(path[:-len(INDEX_SUFFIX)]):
+        return None
+    return index
+
+
+def write_index(segment: str, index: dict):
+    """Write a segment's sidecar index atomically (temp file + rename)."""
+    path = index_path(segment)
+    tmp_path = f"{path}.{os.getpid()}.tmp"
+    with open(tmp_path, "wb") as f:
+        f.write(codec.dumps_bytes(index))
+    os.replace(tmp_path, path)
+
+
+def index_segment(segment: str, write: bool = True, rebuild: bool = False) -> dict:
+    """
+    Get a log file's index, building or extending it if the sidecar is missing or stale.
+
+    A sidecar for a shorter version of the same (uncompressed) file is
+    extended over what was appended; one for a different file
+    (the active log after rotation) is replaced.
+
+    Args:
+        segment: Log file or rotated segment
+        write: Save a newly built index as the sidecar
+        rebuild: Ignore an existing sidecar
+
+    Returns:
+        Index
+    """
+    index = None if rebuild else load_index(segment)
+    compressed = segment.endswith(COMPRESSED_SUFFIXES)
+    if index is not None and (compressed or os.path.getsize(segment) == index["bytes"]):
+        return index
+
+    with open_segment(segment) as data:
+        base = None
+        if (
+            index is not None and not compressed and index["bytes"] < len(data)
+            and index.get("head") == _head(data, index.get("head_bytes", 0))
+        ):
+            base = index
+        index = build_index(data, os.path.basename(index_path(segment)[:-len(INDEX_SUFFIX)]), base=base)
+    if write:
+        write_index(segment, index)
+    return index
+
+
+class LogQuery:
+    """
+    Filter over log entries by event type, node, task and time range.
+
+    A filter left as None matches everything. Times are ISO 8601 strings
+    compared as text, so since/until may be prefixes ("2025-12-07T14"
+    is the whole hour); until is inclusive.
+    """
+
+    def __init__(
+        self,
+        event_types: Optional[Iterable[str]] = None,
+        node_ids: Optional[Iterable[str]] = None,
+        task_ids: Optional[Iterable[str]] = None,
+        since: Optional[str] = None,
+        until: Optional[str] = None
+    ):
+        """
+        Initialize the query.
+
+        Args:
+            event_types: Event types to keep
+            node_ids: Nodes to keep
+            task_ids: Tasks to keep (entries whose data.task_id is one of them)
+            since: Earliest timestamp
+            until: Latest timestamp (inclusive, prefix match)
+        """
+        self.event_types = set(event_types) if event_types else None
+        self.node_ids = set(node_ids) if node_ids else None
+        self.task_ids = set(task_ids) if task_ids else None
+        self.since = since
+        self.until = until
+
+    def in_range(self, start: Optional[str], end: Optional[str]) -> bool:
+        """Check whether a time range overlaps the query's."""
+        if start is None:
+            return self.since is None and self.until is None
+        if self.since is not None and end < self.since:
+            return False
+        return self.until is None or start[:len(self.until)] <= self.until
+
+    def blocks(self, index: dict) -> List[int]:
+        """
+        Blocks of an index that may hold matching entries.
+
+        Returns:
+            Block numbers in file order
+        """
+        candidates = None
+        for field, values in (
+            ("event_types", self.event_types),
+            ("node_ids", self.node_ids),
+            ("task_ids", self.task_ids)
+        ):
+            if values is None:
+                continue
+            postings = index[field]
+            found = set()
+            for value in values:
+                found.update(postings.get(value, ()))
+            candidates = found if candidates is None else candidates & found
+
+        numbers = range(len(index["blocks"])) if candidates is None else sorted(candidates)
+        return [
+            number for number in numbers
+            if self.in_range(index["blocks"][number][3], index["blocks"][number][4])
+        ]
+
+    def matches(self, entry: dict) -> bool:
+        """Check a parsed entry against every filter."""
+        if self.event_types is not None and entry.get("event_type") not in self.event_types:
+            return False
+        if self.node_ids is not None and entry.get("node_id") not in self.node_ids:
+            return False
+        if self.task_ids is not None:
+            data = entry.get("data")
+            if not isinstance(data, dict) or data.get("task_id") not in self.task_ids:
+                return False
+        timestamp = entry.get("timestamp")
+        if self.since is not None or self.until is not None:
+            return timestamp is not None and self.in_range(timestamp, timestamp)
+        return True
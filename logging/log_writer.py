@@ -0,0 +1,390 @@
+"""
+Background Log Writer for the JSON logger.
+
+Moves log file I/O off the event loop: loggers enqueue serialized
+NDJSON lines and a dedicated thread writes them through a persistent
+file handle in batches.
+"""
+
+import asyncio
+import atexit
+import os
+import threading
+import time
+from collections import deque
+from datetime import datetime
+from pathlib import Path
+from typing import Dict, List, Optional
+
+from . import codec
+from .rotation import LogRotator
+
+
+class LogWriter:
+    """
+    Buffered NDJSON writer running on a dedicated thread.
+
+    One writer exists per log file per process and is shared by every
+    JSONLogger writing to that file.
+
+    Flushing:
+    - buffered lines are written once flush_bytes accumulate or
+      flush_interval seconds pass, whichever comes first
+
+    Fsync policies:
+    - never: leave durability to the OS
+    - batch: fsync after every batched write
+    - always: write and fsync every line individually
+
+    Overflow policies (when max_queue lines are waiting):
+    - block: the caller waits for space (backpressure); on an event
+      loop thread write() drops the line instead and write_async()
+      waits off the loop
+    - drop_newest: the new line is discarded
+    - drop_oldest: the oldest queued line is discarded
+
+    Flush and close requests bypass the line queue, so they are never
+    discarded and never wait for space.
+
+    Rotation (see LogRotator) is checked before each batched write.
+    Several processes may append to the same file and any of them may
+    rotate it: before each batched write the writer checks that its
+    handle still refers to the file at path (same inode) and reopens
+    it if another process has moved the file aside.
+    """
+
+    FSYNC_POLICIES = {"never", "batch", "always"}
+    OVERFLOW_POLICIES = {"block", "drop_newest", "drop_oldest"}
+
+    def __init__(
+        self,
+        path: str,
+        max_queue: int = 10000,
+        flush_bytes: int = 64 * 1024,
+        flush_interval: float = 0.5,
+        fsync: str = "never",
+        overflow: str = "block",
+        rotation: str = "none",
+        max_bytes: int = 0,
+        retention_days: int = 0,
+        compression: str = "none",
+        index_segments: bool = True
+    ):
+        """
+        Initialize and start the writer thread.
+
+        Args:
+            path: Log file path (appended to)
+            max_queue: Maximum number of lines waiting to be written (0 = unbounded)
+            flush_bytes: Buffered bytes that trigger a write
+            flush_interval: Maximum seconds a line stays buffered
+            fsync: Fsync policy (never, batch, always)
+            overflow: Overflow policy (block, drop_newest, drop_oldest)
+            rotation: Rotation strategy (daily, size, none)
+            max_bytes: Size cap per log file (0 disables the cap)
+            retention_days: Age after which rotated segments are deleted (0 keeps all)
+            compression: Compression for rotated segments (none, gzip, zstd)
+            index_segments: Write a sidecar index for each rotated segment
+
+        Raises:
+            ValueError: If a policy name is invalid
+        """
+        if fsync not in self.FSYNC_POLICIES:
+            raise ValueError(f"Invalid fsync policy: {fsync}. Must be one of {self.FSYNC_POLICIES}")
+        if overflow not in self.OVERFLOW_POLICIES:
+            raise ValueError(f"Invalid overflow policy: {overflow}. Must be one of {self.OVERFLOW_POLICIES}")
+
+        self.path = path
+        self.flush_bytes = flush_bytes
+        self.flush_interval = flush_interval
+        self.fsync = fsync
+        self.overflow = overflow
+        self.rotator = LogRotator(path, rotation, max_bytes, retention_days, compression, index_segments)
+
+        self.lines_written = 0
+        self.lines_dropped = 0
+        self._unreported_drops = 0
+
+        log_dir = os.path.dirname(path)
+        if log_dir:
+            Path(log_dir).mkdir(parents=True, exist_ok=True)
+
+        # Data lines and control requests travel separately, so overflow
+        # handling only ever discards data lines
+        self.max_queue = max_queue
+        self._lines: deque = deque()
+        self._flushes: List[threading.Event] = []
+        self._lock = threading.Lock()
+        self._not_empty = threading.Condition(self._lock)
+        self._not_full = threading.Condition(self._lock)
+        self._closed = False
+        self._thread = threading.Thread(
+            target=self._run,
+            name=f"log-writer:{os.path.basename(path)}",
+            daemon=True
+        )
+        self._thread.start()
+
+    def _put(self, line: str, wait: bool) -> Optional[bool]:
+        """
+        Enqueue a line, applying the overflow policy.
+
+        Args:
+            line: Serialized log entry
+            wait: Under the block policy, wait for space if the queue is full
+
+        Returns:
+            True if queued, False if dropped, None if the queue is full
+            under the block policy and wait is False
+        """
+        with self._lock:
+            while True:
+                if self._closed:
+                    return False
+                if not self.max_queue or len(self._lines) < self.max_queue:
+                    self._lines.append(line)
+                    self._not_empty.notify()
+                    return True
+                if self.overflow == "drop_oldest":
+                    self._lines.popleft()
+                    self._lines.append(line)
+                    self._count_drop()
+                    return True
+                if self.overflow == "drop_newest":
+                    self._count_drop()
+                    return False
+                if not wait:
+                    return None
+                self._not_full.wait()
+
+    def write(self, line: str) -> bool:
+        """
+        Enqueue one NDJSON line (without trailing newline).
+
+        Never blocks on a thread running an event loop (where callers may
+        hold the context store lock): there a full queue drops the line
+        under the block policy too. Coroutines get backpressure from
+        write_async instead.
+
+        Args:
+            line: Serialized log entry
+
+        Returns:
+            False if the line was dropped by the overflow policy
+        """
+        queued = self._put(line, wait=not _on_event_loop())
+        if queued is None:
+            with self._lock:
+                self._count_drop()
+            return False
+        return queued
+
+    async def write_async(self, line: str) -> bool:
+        """
+        Enqueue one NDJSON line from a coroutine.
+
+        Under the block policy, a full queue makes the caller wait for
+        space in an executor thread rather than stalling the event loop.
+
+        Args:
+            line: Serialized log entry
+
+        Returns:
+            False if the line was dropped by the overflow policy
+        """
+        queued = self._put(line, wait=False)
+        if queued is None:
+            queued = await asyncio.get_running_loop().run_in_executor(None, self._put, line, True)
+        return queued
+
+    def _count_drop(self):
+        """Account for one discarded line. Must be called while holding the lock."""
+        self.lines_dropped += 1
+        self._unreported_drops += 1
+
+    def flush(self, timeout: Optional[float] = None) -> bool:
+        """
+        Block until every line enqueued so far is written.
+
+        Args:
+            timeout: Maximum seconds to wait (None = no limit)
+
+        Returns:
+            True if the flush completed in time
+        """
+        done = threading.Event()
+        with self._lock:
+            if self._closed or not self._thread.is_alive():
+                return True
+            self._flushes.append(done)
+            self._not_empty.notify()
+        return done.wait(timeout)
+
+    def close(self, timeout: Optional[float] = 5.0):
+        """
+        Flush outstanding lines and stop the writer thread.
+
+        Args:
+            timeout: Maximum seconds to wait for the thread
+        """
+        with self._lock:
+            if self._closed:
+                return
+            self._closed = True
+            self._not_empty.notify()
+            # Callers waiting for space give up; their lines are dropped
+            self._not_full.notify_all()
+        self._thread.join(timeout)
+
+    def _run(self):
+        """Writer thread main loop."""
+        f = open(self.path, "a")
+        buffer: List[str] = []
+        buffered_bytes = 0
+        last_flush = time.monotonic()
+
+        self.rotator.prune()
+
+        def write_out():
+            nonlocal f, buffered_bytes, last_flush
+            with self._lock:
+                drops = self._unreported_drops
+                self._unreported_drops = 0
+            if drops:
+                buffer.append(codec.dumps({
+                    "timestamp": datetime.utcnow().isoformat() + "Z",
+                    "event_type": "log_dropped",
+                    "level": "WARNING",
+                    "data": {"dropped": drops}
+                }))
+            if buffer:
+                data = "\n".join(buffer) + "\n"
+                if _rotated_away(f, self.path):
+                    f.close()
+                    f = open(self.path, "a")
+                    self.rotator.rotated_elsewhere()
+                if self.rotator.should_rotate(os.fstat(f.fileno()).st_size, len(data)):
+                    f.close()
+                    self.rotator.rotate()
+                    f = open(self.path, "a")
+                f.write(data)
+                f.flush()
+                if self.fsync != "never":
+                    os.fsync(f.fileno())
+                self.lines_written += len(buffer)
+                buffer.clear()
+            buffered_bytes = 0
+            last_flush = time.monotonic()
+
+        try:
+            while True:
+                with self._lock:
+                    if not self._lines and not self._flushes and not self._closed:
+                        pending = buffer or self._unreported_drops
+                        timeout = max(self.flush_interval - (time.monotonic() - last_flush), 0.0)
+                        self._not_empty.wait(timeout if pending else None)
+                    lines = list(self._lines)
+                    self._lines.clear()
+                    flushes, self._flushes = self._flushes, []
+                    closed = self._closed
+                    if lines:
+                        self._not_full.notify_all()
+
+                for line in lines:
+                    # The flush interval runs from the oldest buffered line
+                    if not buffer:
+                        last_flush = time.monotonic()
+                    buffer.append(line)
+                    buffered_bytes += len(line)
+                    if self.fsync == "always" or buffered_bytes >= self.flush_bytes:
+                        write_out()
+
+                if (
+                    flushes or closed
+                    or ((buffer or self._unreported_drops) and time.monotonic() - last_flush >= self.flush_interval)
+                ):
+                    write_out()
+                for done in flushes:
+                    done.set()
+                if closed:
+                    return
+        finally:
+            f.close()
+            # Anyone who asked for a flush after the thread stopped isn't left waiting
+            with self._lock:
+                flushes, self._flushes = self._flushes, []
+            for done in flushes:
+                done.set()
+
+
+def _rotated_away(f, path: str) -> bool:
+    """Check whether an open log handle no longer refers to the file at path (renamed or removed)."""
+    try:
+        return os.stat(path).st_ino != os.fstat(f.fileno()).st_ino
+    except FileNotFoundError:
+        return True
+
+
+def _on_event_loop() -> bool:
+    """Check whether the calling thread is running an event loop."""
+    try:
+        asyncio.get_running_loop()
+    except RuntimeError:
+        return False
+    return True
+
+
+# Process-wide writers, one per log file
+_writers: Dict[str, LogWriter] = {}
+_writers_pid = os.getpid()
+_writers_lock = threading.Lock()
+_writer_options: dict = {}
+
+
+def configure_log_writers(**options):
+    """
+    Set the options used for log writers created from now on.
+
+    Args:
+        **options: Keyword arguments accepted by LogWriter
+    """
+    _writer_options.update(options)
+
+
+def get_log_writer(path: str) -> LogWriter:
+    """
+    Get the shared writer for a log file, creating it on first use.
+
+    Args:
+        path: Log file path
+
+    Returns:
+        LogWriter instance
+    """
+    global _writers_pid
+
+    key = os.path.abspath(path)
+    with _writers_lock:
+        # Writer threads don't survive fork; start fresh in a child process
+        if _writers_pid != os.getpid():
+            _writers.clear()
+            _writers_pid = os.getpid()
+
+        writer = _writers.get(key)
+        if writer is None:
+            writer = LogWriter(path, **_writer_options)
+            _writers[key] = writer
+        return writer
+
+
+def close_log_writers():
+    """Flush and stop every log writer in this process."""
+    with _writers_lock:
+        writers = list(_writers.values())
+        _writers.clear()
+
+    for writer in writers:
+        writer.close()
+
+
+atexit.register(close_log_writers)
@@ -0,0 +1,183 @@
+"""
+Network I/O Logging Policy.
+
+Decides which network calls are logged and how much of each is kept,
+so network logging can stay enabled without dominating log volume.
+"""
+
+import hashlib
+import itertools
+import random
+from typing import Any, Dict, Optional
+
+from . import codec
+
+
+class NetworkLogPolicy:
+    """
+    Sampling and truncation policy for network_io log entries.
+
+    Modes:
+    - full: log request and response lines with (truncated) bodies and headers
+    - latency_only: log one response line per call with endpoint, status and latency
+    - off: log nothing
+
+    Sampling is decided once per call with should_log, using the rate for
+    the exact endpoint from sample_rates or default_sample_rate otherwise.
+    Failed calls (status >= 400) are always logged.
+    """
+
+    MODES = {"full", "latency_only", "off"}
+
+    def __init__(
+        self,
+        mode: str = "full",
+        default_sample_rate: float = 1.0,
+        sample_rates: Optional[Dict[str, float]] = None,
+        max_body_bytes: int = 4096,
+        include_headers: bool = True
+    ):
+        """
+        Initialize the policy.
+
+        Args:
+            mode: Logging mode (full, latency_only, off)
+            default_sample_rate: Fraction of calls logged for unlisted endpoints
+            sample_rates: Per-endpoint sample rates, keyed by endpoint path
+            max_body_bytes: Bodies larger than this are replaced by a fingerprint
+                (0 disables truncation)
+            include_headers: Log request headers in full mode
+
+        Raises:
+            ValueError: If mode is invalid
+        """
+        if mode not in self.MODES:
+            raise ValueError(f"Invalid network logging mode: {mode}. Must be one of {self.MODES}")
+
+        self.mode = mode
+        self.default_sample_rate = default_sample_rate
+        self.sample_rates = sample_rates or {}
+        self.max_body_bytes = max_body_bytes
+        self.include_headers = include_headers
+
+    @classmethod
+    def from_dict(cls, options: Optional[dict]) -> "NetworkLogPolicy":
+        """
+        Build a policy from a configuration dictionary.
+
+        Args:
+            options: Dictionary with any of the constructor's keyword arguments
+
+        Returns:
+            NetworkLogPolicy instance
+        """
+        return cls(**(options or {}))
+
+    def should_log(self, endpoint: str) -> bool:
+        """
+        Decide whether a call to an endpoint is logged.
+
+        Args:
+            endpoint: Endpoint path
+
+        Returns:
+            True if this call was sampled
+        """
+        if self.mode == "off":
+            return False
+
+        rate = self.sample_rates.get(endpoint, self.default_sample_rate)
+        return rate >= 1.0 or random.random() < rate
+
+    def prepare_body(self, body: Any) -> Any:
+        """
+        Truncate a body that exceeds max_body_bytes.
+
+        Oversized bodies are replaced with their size, a SHA-256
+        fingerprint and a short preview, so identical payloads can
+        still be correlated.
+
+        Small bodies are recognized by a cheap upper bound on their
+        encoded size, which stops counting as soon as it passes
+        max_body_bytes, so they are not encoded just to be measured
+        (the log entry encodes them anyway). Other bodies are encoded
+        once, and the size, fingerprint and preview all reuse it.
+
+        Args:
+            body: Request or response body (already sanitized)
+
+        Returns:
+            The body itself, or a truncation summary
+        """
+        if self.max_body_bytes <= 0 or body is None:
+            return body
+
+        if _encoded_size_ceiling(body, self.max_body_bytes) <= self.max_body_bytes:
+            return body
+
+        raw = body.encode("utf-8", errors="replace") if isinstance(body, str) else codec.dumps_bytes(body, default=str)
+        if len(raw) <= self.max_body_bytes:
+            return body
+
+        return {
+            "_truncated": True,
+            "size_bytes": len(raw),
+            "sha256": hashlib.sha256(raw).hexdigest(),
+            "preview": raw[:min(256, self.max_body_bytes)].decode("utf-8", errors="ignore")
+        }
+
+
+_END = object()
+
+# Longest JSON escape of one character (a non-BMP character escaped as a
+# \uXXXX\uXXXX surrogate pair by the standard library's ensure_ascii), and of a float
+_MAX_CHAR_BYTES = 12
+_MAX_FLOAT_CHARS = 24
+
+
+def _encoded_size_ceiling(value: Any, limit: int) -> int:
+    """
+    Upper bound on the encoded size of a body, counted only until it passes limit.
+
+    Containers are walked one element at a time, so the work is bounded
+    by limit rather than by the size of the body.
+
+    Args:
+        value: Body (str, or JSON-compatible dicts, lists and scalars)
+        limit: Size past which counting stops
+
+    Returns:
+        Size in bytes the encoding can't exceed, or a value above limit
+        (also for values only encodable through str())
+    """
+    if isinstance(value, str):
+        return len(value) * 4
+
+    size = 0
+    pending = [iter((value,))]
+    while pending and size <= limit:
+        item = next(pending[-1], _END)
+        if item is _END:
+            pending.pop()
+            continue
+
+        # Separator or colon after each element
+        size += 1
+        if isinstance(item, str):
+            size += len(item) * _MAX_CHAR_BYTES + 2
+        elif isinstance(item, dict):
+            size += 2
+            pending.append(itertools.chain.from_iterable(item.items()))
+        elif isinstance(item, (list, tuple)):
+            size += 2
+            pending.append(iter(item))
+        # Scalars get 2 extra for the quotes they take as a dict key
+        elif item is None or isinstance(item, bool):
+            size += 7
+        elif isinstance(item, int):
+            size += len(str(item)) + 2
+        elif isinstance(item, float):
+            size += _MAX_FLOAT_CHARS + 2
+        else:
+            return limit + 1
+    return size
@@ -0,0 +1,235 @@
+"""
+Log Rotation for the JSON logger.
+
+Rotates NDJSON log files daily or by size, indexes and optionally
+compresses rotated segments, and prunes segments past the retention
+period.
+"""
+
+import gzip
+import os
+import shutil
+import threading
+import time
+from datetime import datetime
+from typing import List, Optional
+
+from .log_index import index_path, index_segment
+
+try:
+    import zstandard
+except ImportError:  # Optional dependency; gzip is used instead
+    zstandard = None
+
+
+class LogRotator:
+    """
+    Rotation policy for one log file.
+
+    Strategies:
+    - daily: start a new file when the UTC date changes
+    - size: start a new file when it would exceed max_bytes
+    - none: never rotate
+
+    With daily rotation max_bytes still applies as a size cap. Writers
+    in other processes sharing the file notice a rotation by its inode
+    and reopen the new file (see LogWriter).
+    Rotated segments are renamed to <stem>.<YYYYmmdd-HHMMSS-ffffff><ext> next to the
+    active file. In the background, each gets a sidecar index
+    (<segment>.idx, see log_index) and is then compressed when
+    compression is set.
+    """
+
+    STRATEGIES = {"daily", "size", "none"}
+    COMPRESSIONS = {"none", "gzip", "zstd"}
+
+    def __init__(
+        self,
+        path: str,
+        strategy: str = "daily",
+        max_bytes: int = 100 * 1024 * 1024,
+        retention_days: int = 30,
+        compression: str = "none",
+        index: bool = True
+    ):
+        """
+        Initialize the rotator.
+
+        Args:
+            path: Active log file path
+            strategy: Rotation strategy (daily, size, none)
+            max_bytes: Size cap per file (0 disables the cap)
+            retention_days: Delete rotated segments older than this (0 keeps all)
+            compression: Compression for rotated segments (none, gzip, zstd)
+            index: Write a sidecar index for each rotated segment
+
+        Raises:
+            ValueError: If strategy or compression is invalid
+        """
+        if strategy not in self.STRATEGIES:
+            raise ValueError(f"Invalid rotation strategy: {strategy}. Must be one of {self.STRATEGIES}")
+        if compression not in self.COMPRESSIONS:
+            raise ValueError(f"Invalid compression: {compression}. Must be one of {self.COMPRESSIONS}")
+
+        self.path = path
+        self.strategy = strategy
+        self.max_bytes = max_bytes
+        self.retention_days = retention_days
+        self.index = index
+
+        # Fall back to gzip when zstandard isn't installed
+        if compression == "zstd" and zstandard is None:
+            compression = "gzip"
+        self.compression = compression
+
+        directory, filename = os.path.split(os.path.abspath(path))
+        self.directory = directory
+        self.stem, self.ext = os.path.splitext(filename)
+
+        self._opened_day = self._current_day()
+        if os.path.exists(path):
+            self._opened_day = time.strftime("%Y%m%d", time.gmtime(os.path.getmtime(path)))
+
+    @staticmethod
+    def _current_day() -> str:
+        """Current UTC date as YYYYmmdd."""
+        return datetime.utcnow().strftime("%Y%m%d")
+
+    def should_rotate(self, current_size: int, incoming_bytes: int) -> bool:
+        """
+        Decide whether to rotate before writing the next batch.
+
+        Args:
+            current_size: Current size of the active file in bytes
+            incoming_bytes: Size of the batch about to be written
+
+        Returns:
+            True if the active file should be rotated first
+        """
+        if self.strategy == "none" or current_size == 0:
+            return False
+
+        if self.strategy == "daily" and self._current_day() != self._opened_day:
+            return True
+
+        return self.max_bytes > 0 and current_size + incoming_bytes > self.max_bytes
+
+    def rotate(self) -> Optional[str]:
+        """
+        Move the active file aside as a new segment.
+
+        The caller must have closed its handle to the active file and
+        reopen it afterwards.
+
+        Returns:
+            Path of the rotated segment (before compression), or None
+        """
+        if not os.path.exists(self.path):
+            return None
+
+        stamp = datetime.utcnow().strftime("%Y%m%d-%H%M%S-%f")
+        segment = os.path.join(self.directory, f"{self.stem}.{stamp}{self.ext}")
+        suffix = 1
+        while os.path.exists(segment) or self._compressed_exists(segment):
+            segment = os.path.join(self.directory, f"{self.stem}.{stamp}-{suffix}{self.ext}")
+            suffix += 1
+
+        os.replace(self.path, segment)
+        self._opened_day = self._current_day()
+
+        threading.Thread(
+            target=self._finish_segment,
+            args=(segment,),
+            name=f"log-rotate:{os.path.basename(segment)}",
+            daemon=True
+        ).start()
+
+        return segment
+
+    def rotated_elsewhere(self):
+        """Note that another process rotated the active file, so the file at path was started today."""
+        self._opened_day = self._current_day()
+
+    def _compressed_exists(self, segment: str) -> bool:
+        """Check whether a compressed copy of a segment name exists."""
+        return os.path.exists(f"{segment}.gz") or os.path.exists(f"{segment}.zst")
+
+    def _finish_segment(self, segment: str):
+        """Index and compress a rotated segment and apply retention (runs on its own thread)."""
+        try:
+            if self.index:
+                # Before compressing, while the segment can still be memory-mapped
+                try:
+                    index_segment(segment)
+                except (IOError, ValueError) as e:
+                    print(f"Warning: Could not index log segment {segment}: {e}")
+            self.compress(segment)
+        finally:
+            self.prune()
+
+    def compress(self, segment: str) -> str:
+        """
+        Compress a rotated segment in place according to the policy.
+
+        Args:
+            segment: Path of an uncompressed segment
+
+        Returns:
+            Path of the resulting segment
+        """
+        if self.compression == "none":
+            return segment
+
+        if self.compression == "zstd":
+            target = f"{segment}.zst"
+            with open(segment, "rb") as src, open(f"{target}.tmp", "wb") as dst:
+                zstandard.ZstdCompressor().copy_stream(src, dst)
+        else:
+            target = f"{segment}.gz"
+            with open(segment, "rb") as src, gzip.open(f"{target}.tmp", "wb") as dst:
+                shutil.copyfileobj(src, dst)
+
+        os.replace(f"{target}.tmp", target)
+        os.remove(segment)
+        return target
+
+    def segments(self) -> List[str]:
+        """
+        List rotated segments of this log, oldest first.
+
+        Returns:
+            Segment paths (compressed or not)
+        """
+        prefix = f"{self.stem}."
+        found = []
+        for name in os.listdir(self.directory):
+            if not name.startswith(prefix) or name.endswith(".tmp"):
+                continue
+            base = name[:-len(".gz")] if name.endswith(".gz") else name
+            base = base[:-len(".zst")] if base.endswith(".zst") else base
+            if base.endswith(self.ext) and base != f"{self.stem}{self.ext}":
+                found.append(os.path.join(self.directory, name))
+        return sorted(found)
+
+    def prune(self) -> List[str]:
+        """
+        Delete rotated segments older than the retention period.
+
+        Returns:
+            Paths that were deleted
+        """
+        if self.retention_days <= 0:
+            return []
+
+        cutoff = time.time() - self.retention_days * 86400
+        removed = []
+        for segment in self.segments():
+            try:
+                if os.path.getmtime(segment) < cutoff:
+                    os.remove(segment)
+                    removed.append(segment)
+                    if os.path.exists(index_path(segment)):
+                        os.remove(index_path(segment))
+            except OSError:
+                pass
+        return removed
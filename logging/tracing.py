@@ -0,0 +1,173 @@
+"""
+Distributed Tracing for the Autonomous Development Team.
+
+Trace and span ids follow W3C Trace Context: the current span lives in
+a context variable, travels between processes in a traceparent header
+(00-<32 hex trace id>-<16 hex span id>-01), and is picked up by
+JSONLogger, whose entries use the trace id as correlation_id and carry
+the span id. Finished spans are logged as "span" events with their
+start time and duration, so a task's lifecycle across the lead, the
+server and the worker can be laid out as a waterfall.
+"""
+
+import contextlib
+import contextvars
+import re
+import time
+import uuid
+from typing import Iterator, Optional, Tuple
+
+
+# Header carrying the caller's span to the MCP server
+TRACE_HEADER = "traceparent"
+
+# Trace context for everything running in the current task: (trace id, span id)
+_current_span: contextvars.ContextVar[Optional[Tuple[str, str]]] = contextvars.ContextVar(
+    "current_span", default=None
+)
+
+_TRACEPARENT = re.compile(r"^00-([0-9a-f]{32})-([0-9a-f]{16})-[0-9a-f]{2}$")
+
+
+def new_trace_id() -> str:
+    """Random 32 hex digit trace id."""
+    return uuid.uuid4().hex
+
+
+def new_span_id() -> str:
+    """Random 16 hex digit span id."""
+    return uuid.uuid4().hex[:16]
+
+
+def current_span() -> Optional[Tuple[str, str]]:
+    """(trace id, span id) of the span in scope, if any."""
+    return _current_span.get()
+
+
+def format_traceparent(context: Optional[Tuple[str, str]] = None) -> Optional[str]:
+    """
+    Encode a span as a traceparent header value.
+
+    Args:
+        context: (trace id, span id); the current span if omitted
+
+    Returns:
+        Header value, or None outside any span
+    """
+    context = context or _current_span.get()
+    if context is None:
+        return None
+    return f"00-{context[0]}-{context[1]}-01"
+
+
+def parse_traceparent(value: Optional[str]) -> Optional[Tuple[str, str]]:
+    """
+    Decode a traceparent header value.
+
+    Returns:
+        (trace id, span id), or None if value is missing or malformed
+    """
+    if not value:
+        return None
+    match = _TRACEPARENT.match(value.strip().lower())
+    if match is None:
+        return None
+    return match.group(1), match.group(2)
+
+
+class Tracer:
+    """
+    Records spans as "span" log events through a JSONLogger.
+
+    A span event's data holds trace_id, span_id, parent_id, name,
+    start (Unix seconds), duration_ms and the span's attributes.
+    """
+
+    def __init__(self, logger):
+        """
+        Initialize the tracer.
+
+        Args:
+            logger: JSONLogger the span events are written to
+        """
+        self.logger = logger
+
+    def record(
+        self,
+        name: str,
+        trace_id: str,
+        span_id: str,
+        parent_id: Optional[str],
+        start: float,
+        duration: float,
+        **attributes
+    ):
+        """
+        Log a finished span (for spans timed elsewhere, e.g. a task's time in the queue).
+
+        Does no I/O on the calling thread, so it may be called while holding a lock.
+
+        Args:
+            name: Span name
+            trace_id: Trace the span belongs to
+            span_id: Span id
+            parent_id: Parent span id (None for a root span)
+            start: Start time (Unix seconds)
+            duration: Duration in seconds
+            **attributes: Extra span data (ids, status, sizes)
+        """
+        self.logger.log_sync(
+            "span",
+            {
+                "trace_id": trace_id,
+                "span_id": span_id,
+                "parent_id": parent_id,
+                "name": name,
+                "start": round(start, 6),
+                "duration_ms": round(duration * 1000, 3),
+                **attributes
+            },
+            correlation_id=trace_id,
+            sanitized=True
+        )
+
+    @contextlib.contextmanager
+    def span(
+        self,
+        name: str,
+        parent: Optional[Tuple[str, str]] = None,
+        **attributes
+    ) -> Iterator[dict]:
+        """
+        Run a block as a span, making it the current span inside.
+
+        Args:
+            name: Span name
+            parent: (trace id, span id) to continue; the current span if
+                omitted, and a new trace if there is none
+            **attributes: Extra span data; the yielded dict can be updated
+                inside the block to add more
+
+        Yields:
+            The span's attributes
+        """
+        parent = parent or _current_span.get()
+        trace_id = parent[0] if parent else new_trace_id()
+        span_id = new_span_id()
+
+        token = _current_span.set((trace_id, span_id))
+        start = time.time()
+        started = time.perf_counter()
+        try:
+            yield attributes
+        except BaseException as e:
+            attributes.setdefault("error", type(e).__name__)
+            raise
+        finally:
+            try:
+                self.record(
+                    name, trace_id, span_id, parent[1] if parent else None,
+                    start, time.perf_counter() - started, **attributes
+                )
+            finally:
+                _current_span.reset(token)
@@ -20,10 +20,14 @@ from typing import List
 
 from config.settings import ProjectConfig
 from project_lead.lead import ProjectLead
-from workers.worker import Worker, WorkerType
+from workers.mcp_client import configure_mcp_clients, close_mcp_sessions, register_in_process_server
+from workers.worker import Worker, WorkerType, create_worker
+from workers.pool import WorkerPool
 from display.terminal_ui import TerminalStatusDisplay
 from mcp_server.server import MCPServer
 from logging.json_logger import JSONLogger
+from logging.log_writer import configure_log_writers, close_log_writers
+from logging.network_policy import NetworkLogPolicy
 
 
 def parse_args():
@@ -181,12 +185,8 @@ async def initialize_workers(
                 worker_type = WorkerType.DEVELOPER
 
             for _ in range(actual_count):
-                worker = Worker(
-                    worker_id=f"worker-{worker_id:03d}",
-                    worker_type=worker_type,
-                    mcp_host=mcp_host,
-                    mcp_port=mcp_port,
-                    log_file=log_file
+                worker = create_worker(
+                    f"worker-{worker_id:03d}", worker_type, config, mcp_host, mcp_port, log_file
                 )
                 workers.append(worker)
                 worker_id += 1
@@ -219,6 +219,8 @@ async def cleanup(mcp_server_task, worker_tasks, display_task):
     # Wait for cancellation
     await asyncio.sleep(1)
 
+    await close_mcp_sessions()
+
     print("Cleanup complete")
 
 
@@ -240,6 +242,26 @@ async def main():
         # Ensure log directory exists
         os.makedirs("logs", exist_ok=True)
 
+        # Connection pool, timeout and retry settings apply to every MCP client created below
+        configure_mcp_clients(
+            max_connections=config.mcp_max_connections,
+            request_timeout=config.mcp_request_timeout
+        )
+
+        # Background log writer settings apply to every logger created below
+        configure_log_writers(
+            max_queue=config.log_queue_size,
+            flush_bytes=config.log_flush_bytes,
+            flush_interval=config.log_flush_interval_ms / 1000,
+            fsync=config.log_fsync_policy,
+            overflow=config.log_overflow_policy,
+            rotation=config.log_rotation,
+            max_bytes=config.log_max_file_size_mb * 1024 * 1024,
+            retention_days=config.log_retention_days,
+            compression=config.log_compression,
+            index_segments=config.log_index_segments
+        )
+
         # Load requirements
         requirements = load_requirements(args.requirements)
         print(f"\nLoaded requirements from: {args.requirements}")
@@ -276,12 +298,20 @@ async def main():
         mcp_server = MCPServer(
             host=mcp_host,
             port=mcp_port,
-            log_file=log_file
+            context_store_path=config.context_store_path,
+            storage_backend=config.context_store_backend,
+            result_cache=config.context_store_result_cache,
+            log_file=log_file,
+            network_log_policy=NetworkLogPolicy.from_dict(config.network_log_policy)
         )
 
         mcp_server_task = asyncio.create_task(mcp_server.start())
         await asyncio.sleep(2)  # Wait for server to start
 
+        # Local components call the tool handlers directly; HTTP stays up for remote workers
+        if config.mcp_transport == "in_process":
+            register_in_process_server(mcp_server, mcp_host, mcp_port)
+
         # Initialize project lead
         print("Initializing project lead...")
         lead = ProjectLead(
@@ -308,10 +338,25 @@ async def main():
 
         # Start worker tasks
         print("\nStarting worker tasks...")
-        worker_tasks = [
-            asyncio.create_task(worker.work_loop())
-            for worker in workers
-        ]
+        pool = WorkerPool(
+            worker_factory=lambda worker_id, worker_type: create_worker(
+                worker_id, worker_type, config, mcp_host, mcp_port, log_file
+            ),
+            min_workers=config.min_workers,
+            max_workers=config.max_workers,
+            mcp_host=mcp_host,
+            mcp_port=mcp_port,
+            log_file=log_file
+        )
+        for worker in workers:
+            pool.add_worker(worker)
+        workers = pool.workers
+
+        # Grow and shrink the pool with the ready queue
+        autoscale_task = None
+        if config.auto_scale:
+            print(f"Auto-scaling between {config.min_workers} and {config.max_workers} workers")
+            autoscale_task = asyncio.create_task(pool.autoscale())
 
         # Start display (if not disabled)
         display_task = None
@@ -322,7 +367,8 @@ async def main():
                 workers=workers,
                 mcp_host=mcp_host,
                 mcp_port=mcp_port,
-                refresh_rate=config.display_refresh_rate_hz
+                refresh_rate=1.0 / config.display_refresh_rate_hz,
+                max_redraw_hz=config.display_max_redraw_hz
             )
             display_task = asyncio.create_task(display.run())
 
@@ -337,11 +383,13 @@ async def main():
             print("\n\nReceived interrupt signal...")
         finally:
             # Stop workers
-            for worker in workers:
-                await worker.stop()
+            if autoscale_task:
+                autoscale_task.cancel()
+            await pool.stop()
 
             # Cleanup
-            await cleanup(mcp_server_task, worker_tasks, display_task)
+            await cleanup(mcp_server_task, list(pool.worker_tasks.values()), display_task)
+            await mcp_server.stop()
 
             await logger.log(
                 "system_stopped",
@@ -362,6 +410,13 @@ async def main():
             print(f"  Tasks Created: {summary['tasks_created']}")
             print(f"  Workers Used: {summary['workers']}")
             print(f"  Status: {summary['status']}")
+
+            schedule = summary.get("schedule") or {}
+            if schedule.get("predicted_makespan_seconds") is not None:
+                print(f"  Makespan: predicted {schedule['predicted_makespan_seconds']}s, "
+                      f"actual {schedule.get('actual_makespan_seconds')}s")
+
+            close_log_writers()
             print(f"\nLogs saved to: {log_file}\n")
 
     except FileNotFoundError as e:
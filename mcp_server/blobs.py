@@ -0,0 +1,204 @@
+"""
+Content-Addressed Blob Store.
+
+Holds large task outputs and artifacts out of line, so task records and
+tool responses carry a small reference ({"blob": sha256, "size": n})
+instead of the content. Artifacts are uploaded in chunks; each chunk is
+a blob of its own and a manifest blob lists them in order.
+"""
+
+import hashlib
+import os
+import re
+import tempfile
+from typing import Any, List, Optional
+
+from logging import codec
+
+
+# Largest chunk accepted per upload_blob_chunk call and returned per get_blob call
+MAX_CHUNK_BYTES = 1024 * 1024
+
+_DIGEST = re.compile(r"^[0-9a-f]{64}$")
+
+
+class BlobStore:
+    """
+    Blobs stored by SHA-256 under <storage_path>.blobs/<first 2 hex>/<digest>.
+
+    Writes are atomic (temp file + rename) and idempotent, so the same
+    content uploaded twice, or by two workers, is stored once.
+    """
+
+    def __init__(self, directory: str):
+        """
+        Initialize the blob store.
+
+        Args:
+            directory: Root directory for blobs
+        """
+        self.directory = directory
+        os.makedirs(directory, exist_ok=True)
+
+    def _path(self, digest: str) -> str:
+        """
+        Path of a blob.
+
+        Raises:
+            ValueError: If digest is not a SHA-256 hex string
+        """
+        if not isinstance(digest, str) or not _DIGEST.match(digest):
+            raise ValueError(f"Invalid blob hash: {digest!r}")
+        return os.path.join(self.directory, digest[:2], digest)
+
+    def put(self, data: bytes) -> str:
+        """
+        Store content.
+
+        Args:
+            data: Blob content
+
+        Returns:
+            SHA-256 hex digest of the content
+        """
+        digest = hashlib.sha256(data).hexdigest()
+        path = self._path(digest)
+        if os.path.exists(path):
+            return digest
+
+        # A unique temp file per call: concurrent puts of the same content
+        # from other threads or coroutines each write their own copy
+        directory = os.path.dirname(path)
+        os.makedirs(directory, exist_ok=True)
+        fd, tmp_path = tempfile.mkstemp(dir=directory, prefix=f"{digest}.", suffix=".tmp")
+        try:
+            with os.fdopen(fd, 'wb') as f:
+                f.write(data)
+            os.replace(tmp_path, path)
+        except OSError:
+            # Content-addressed: a blob another writer stored meanwhile is this one
+            if not os.path.exists(path):
+                raise
+        finally:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
+        return digest
+
+    def exists(self, digest: str) -> bool:
+        """Check whether a blob is stored."""
+        return os.path.exists(self._path(digest))
+
+    def size(self, digest: str) -> int:
+        """
+        Size of a blob in bytes.
+
+        Raises:
+            KeyError: If the blob is not stored
+        """
+        try:
+            return os.path.getsize(self._path(digest))
+        except FileNotFoundError:
+            raise KeyError(digest)
+
+    def read(self, digest: str, offset: int = 0, length: Optional[int] = None) -> bytes:
+        """
+        Read (part of) a blob.
+
+        Args:
+            digest: Blob hash
+            offset: First byte to read
+            length: Bytes to read (None = to the end)
+
+        Returns:
+            Content
+
+        Raises:
+            KeyError: If the blob is not stored
+        """
+        try:
+            with open(self._path(digest), 'rb') as f:
+                f.seek(offset)
+                return f.read() if length is None else f.read(length)
+        except FileNotFoundError:
+            raise KeyError(digest)
+
+    def commit(self, chunks: List[str], media_type: Optional[str] = None) -> dict:
+        """
+        Store a manifest for chunks uploaded with put().
+
+        Args:
+            chunks: Chunk hashes, in order
+            media_type: Content type of the assembled artifact
+
+        Returns:
+            Reference: {"blob": manifest hash, "size", "chunks", "media_type"}
+
+        Raises:
+            KeyError: If a chunk is not stored
+        """
+        size = sum(self.size(digest) for digest in chunks)
+        manifest = {"chunks": list(chunks), "size": size, "media_type": media_type}
+        return {
+            "blob": self.put(codec.dumps_bytes(manifest)),
+            "size": size,
+            "chunks": len(chunks),
+            "media_type": media_type
+        }
+
+    def read_artifact(self, digest: str, chunked: bool, offset: int = 0, length: int = MAX_CHUNK_BYTES) -> bytes:
+        """
+        Read a byte range of a blob or of a chunked artifact.
+
+        Args:
+            digest: Blob hash (the manifest hash when chunked)
+            chunked: Whether digest is a manifest from commit()
+            offset: First byte of the assembled content to read
+            length: Maximum bytes to read
+
+        Returns:
+            Content
+
+        Raises:
+            KeyError: If the blob or one of its chunks is not stored
+        """
+        if not chunked:
+            return self.read(digest, offset, length)
+
+        manifest = codec.loads(self.read(digest))
+        parts = []
+        position = 0
+        for chunk in manifest["chunks"]:
+            chunk_size = self.size(chunk)
+            if position + chunk_size > offset and length > 0:
+                part = self.read(chunk, max(offset - position, 0), length)
+                parts.append(part)
+                length -= len(part)
+            position += chunk_size
+            if length <= 0:
+                break
+        return b"".join(parts)
+
+
+def offload_large_values(value: Any, blobs: BlobStore, threshold: int) -> Any:
+    """
+    Replace long strings inside a result with blob references.
+
+    Args:
+        value: Result (dicts, lists and scalars)
+        blobs: Where offloaded strings go
+        threshold: Strings longer than this many characters are offloaded
+
+    Returns:
+        The result with {"blob", "size", "media_type"} in place of long strings
+        (unchanged objects are returned as is)
+    """
+    if isinstance(value, str):
+        if len(value) <= threshold:
+            return value
+        data = value.encode("utf-8")
+        return {"blob": blobs.put(data), "size": len(data), "media_type": "text/plain; charset=utf-8"}
+    if isinstance(value, dict):
+        return {key: offload_large_values(item, blobs, threshold) for key, item in value.items()}
+    if isinstance(value, list):
+        return [offload_large_values(item, blobs, threshold) for item in value]
+    return value
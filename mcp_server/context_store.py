@@ -2,17 +2,33 @@
 Context Store for MCP Server.
 
 Manages project state, tasks, workers, and conversation history.
-Uses JSON file storage with in-memory caching for performance.
+State is held in memory; mutations are persisted through a storage
+backend: an append-only journal periodically compacted into a JSON
+snapshot, or a SQLite database in WAL mode.
 """
 
-import json
 import os
+import time
+import uuid
+import heapq
 import asyncio
-from typing import Dict, List, Optional, Any
+import contextlib
+from collections import deque
+from typing import Callable, Dict, List, Optional, Any, Set, Tuple
 from pathlib import Path
 from datetime import datetime
 from enum import Enum
 
+from .storage import create_storage_backend
+from .history import ConversationHistory, entry_task_id
+from .blobs import BlobStore
+from .streams import TaskOutputStreams
+from .result_cache import ResultCache, task_cache_key
+from .metrics import MetricsRegistry
+from .scheduling import DurationModel, critical_path, upward_ranks
+from .matching import TaskMatcher
+from logging.tracing import Tracer, current_span, new_span_id, new_trace_id
+
 
 class TaskStatus(Enum):
     """Task status enumeration."""
@@ -29,10 +45,105 @@ class WorkerStatus(Enum):
     IDLE = "idle"
     ACTIVE = "active"
     BUSY = "busy"
+    DRAINING = "draining"
     ERROR = "error"
     STOPPED = "stopped"
 
 
+# Ready-index bucket for tasks that don't require any capability
+ANY_CAPABILITY = "*"
+
+# Statuses a task may be set to
+TASK_STATUS_VALUES = frozenset(status.value for status in TaskStatus)
+
+# Statuses during which a task is held by a worker under a lease
+LEASED_STATUSES = {TaskStatus.ASSIGNED.value, TaskStatus.IN_PROGRESS.value}
+
+# Worker statuses counted as active in the project status
+ACTIVE_WORKER_STATUSES = (WorkerStatus.ACTIVE.value, WorkerStatus.BUSY.value)
+
+# Statuses a worker may report in a heartbeat
+WORKER_STATUS_VALUES = frozenset(status.value for status in WorkerStatus)
+
+# Minimum seconds between re-rankings after the duration model is recalibrated
+RANK_REFRESH_SECONDS = 1.0
+
+
+def _copy_value(value: Any) -> Any:
+    """Copy the dicts and lists of a JSON-style value (scalars are immutable and shared)."""
+    if isinstance(value, dict):
+        return {key: _copy_value(item) for key, item in value.items()}
+    if isinstance(value, list):
+        return [_copy_value(item) for item in value]
+    return value
+
+
+def _copy_entity(entity: dict) -> dict:
+    """
+    Copy a task or worker record so later in-place updates don't show through.
+
+    Nested dicts and lists (trace, result, dependencies, ...) are copied
+    too: the copies go to the storage writer thread and the read view,
+    while the loop keeps mutating the originals.
+    """
+    return _copy_value(entity)
+
+
+class ReentrantLock:
+    """
+    asyncio lock that the task holding it may acquire again.
+
+    Lets a store transaction hold the lock across several
+    store calls that each take the lock themselves.
+    """
+
+    def __init__(
+        self,
+        on_wait: Optional[Callable[[float], None]] = None,
+        on_release: Optional[Callable[[], None]] = None
+    ):
+        """
+        Initialize the lock.
+
+        Args:
+            on_wait: Called with the seconds spent waiting for each outermost acquire
+            on_release: Called just before each outermost release
+        """
+        self._lock = asyncio.Lock()
+        self._owner = None
+        self._depth = 0
+        self.on_wait = on_wait
+        self.on_release = on_release
+
+    def locked(self) -> bool:
+        """Check whether any task holds the lock."""
+        return self._lock.locked()
+
+    def held_by_current_task(self) -> bool:
+        """Check whether the running task already holds the lock."""
+        return self._owner is not None and self._owner is asyncio.current_task()
+
+    async def __aenter__(self):
+        if not self.held_by_current_task():
+            started = time.perf_counter()
+            await self._lock.acquire()
+            self._owner = asyncio.current_task()
+            if self.on_wait is not None:
+                self.on_wait(time.perf_counter() - started)
+        self._depth += 1
+        return self
+
+    async def __aexit__(self, exc_type, exc_val, exc_tb):
+        self._depth -= 1
+        if self._depth == 0:
+            try:
+                if self.on_release is not None:
+                    self.on_release()
+            finally:
+                self._owner = None
+                self._lock.release()
+
+
 class ContextStore:
     """
     Manages all project context and state.
@@ -41,19 +152,158 @@ class ContextStore:
     - Project metadata and plan
     - Task definitions and status
     - Worker information and assignments
-    - Conversation history
+    - Conversation history (recent entries in memory, older ones in paged segments)
+    - Large results and artifacts as content-addressed blobs, live task output
     - Metrics and statistics
+
+    Dispatch is served from in-memory indexes rebuilt on load:
+    - per-task count of unmet dependencies and a reverse dependents map
+    - per-capability heaps of ready (pending, unblocked) task ids
+    - task ids bucketed by status
+    - upward rank (critical-path length to the end of the plan) per task
+
+    Ready tasks are dispatched highest upward rank first, creation order
+    breaking ties. Ranks use estimated_hours calibrated by the actual
+    durations of completed tasks. They are settled lazily, before a
+    claim or report reads them: new tasks re-rank only themselves and
+    their ancestors, in one pass per lock hold (so a create_tasks call
+    is one pass), and a recalibration re-ranks the unfinished tasks at
+    most once per RANK_REFRESH_SECONDS.
+
+    Among the top ready candidates, a claiming worker gets the one that
+    best combines priority with fit (see TaskMatcher). A worker must have
+    at least min_coverage of a task's required capabilities (all of them
+    by default); a task that has waited max_defer_seconds may also go to
+    a worker that covers only some, which is counted in
+    mcp_partial_match_claims_total. A task is left for a parked worker
+    that fits it clearly better, unless it has already waited
+    max_defer_seconds. A newly ready task wakes the parked worker that
+    fits it best among those that cover it.
+
+    Claimed tasks are held under a lease that workers renew through
+    status updates; tasks whose lease expires return to the ready queue.
+    Claims may long-poll: idle claimers park on a per-capability waiter
+    and are woken as soon as a matching task becomes ready.
+
+    Workers send heartbeats with their status; a worker silent for
+    worker_timeout_seconds is marked stopped. A drain request is handed
+    to the worker on its next heartbeat.
+
+    Every task, worker, project or metrics mutation bumps a status version
+    and is remembered in a bounded change log, so status readers can ask
+    for only what changed since the version they last saw. Versions
+    restart with the process, so they are only comparable within one
+    status epoch (a random id per store instance, sent along with them).
+
+    Task completions and failures, and the moment every task is
+    completed or failed, are emitted as events to a bounded in-memory
+    event log that the lead long-polls (wait_for_events), instead of
+    polling the status.
+
+    Locking: the store lock guards dispatch state (tasks, workers,
+    metrics and their indexes), which a claim or completion changes
+    together; conversation history has a lock of its own, so paging it
+    doesn't wait for dispatch. Appending an entry journals it, so it
+    takes the store lock too (always before the history lock). Journal and
+    snapshot I/O happen on the storage writer thread, never under the
+    lock; flush() waits for them. Each time the store lock is released,
+    copies of the tasks and workers that changed are published to a read
+    view, so get_task, get_worker and full status reads don't wait behind
+    an open transaction.
+
+    When a task is claimed it gets a cache_key (its inputs, dependency
+    results and the claiming worker's model); completed results are kept
+    under that key in <storage_path>.cache/ across projects, so reruns of
+    the same requirements can skip execution.
+
+    Lock wait time, persistence duration, ready-queue depth, worker
+    busy/idle time and result cache hits are exported through a
+    MetricsRegistry.
+
+    Every task carries trace context ("trace": trace_id, span_id,
+    parent_id, created), continuing the trace of the call that created
+    it. With a tracer, the store records the task's lifecycle as spans
+    under that root: task.blocked (created until its dependencies were
+    met), task.queued (ready until claimed), task.leased (claimed until
+    completed or failed) and the root task span itself.
     """
 
-    def __init__(self, storage_path: str = "context/project_store.json"):
+    def __init__(
+        self,
+        storage_path: str = "context/project_store.json",
+        snapshot_interval: int = 500,
+        fsync: bool = False,
+        lease_seconds: float = 120.0,
+        metrics: Optional[MetricsRegistry] = None,
+        change_log_size: int = 10000,
+        event_log_size: int = 1000,
+        matcher: Optional[TaskMatcher] = None,
+        match_candidates: int = 16,
+        max_defer_seconds: float = 30.0,
+        priority_weight: float = 4.0,
+        min_coverage: float = 1.0,
+        worker_timeout_seconds: float = 60.0,
+        history_memory_entries: int = 1000,
+        history_segment_bytes: int = 4 * 1024 * 1024,
+        background_persistence: bool = True,
+        storage_backend: str = "journal",
+        output_buffer_chars: int = 64 * 1024,
+        result_cache: bool = True,
+        tracer: Optional[Tracer] = None
+    ):
         """
         Initialize the context store.
 
         Args:
-            storage_path: Path to the JSON storage file
+            storage_path: Path to the JSON snapshot file (the sqlite backend uses it with a .db extension)
+            snapshot_interval: Journal records written between snapshots
+            fsync: Make every journal write durable against power loss
+            lease_seconds: How long a claimed task stays with a silent worker
+            metrics: Registry to export store metrics to (a private one if omitted)
+            change_log_size: Status changes remembered for delta queries
+            event_log_size: Task events remembered for wait_for_events
+            matcher: Worker/task fit scorer (default weights if omitted)
+            match_candidates: Top ready tasks considered per claim
+            max_defer_seconds: How long a task may be held back for a better-fitting worker
+            priority_weight: Weight of a candidate's rank relative to the top candidate's
+            min_coverage: Share of a task's required capabilities a worker must have
+                (a task that waited max_defer_seconds goes to any worker with one of them)
+            worker_timeout_seconds: Heartbeat silence after which a worker is marked stopped
+            history_memory_entries: Conversation entries kept in memory (older ones are spilled to disk)
+            history_segment_bytes: Size of each conversation history segment file
+            background_persistence: Write the journal and snapshots on a writer thread
+            storage_backend: journal (NDJSON journal + JSON snapshot) or sqlite (WAL-mode database)
+            output_buffer_chars: Recent live output kept in memory per running task
+            result_cache: Reuse results of identical earlier tasks instead of executing them
+            tracer: Records task lifecycle spans (none are recorded if omitted)
         """
         self.storage_path = storage_path
-        self.lock = asyncio.Lock()
+        self.tracer = tracer
+        self.lease_seconds = lease_seconds
+        self.matcher = matcher or TaskMatcher()
+        self.match_candidates = match_candidates
+        self.max_defer_seconds = max_defer_seconds
+        self.priority_weight = priority_weight
+        self.min_coverage = min_coverage
+        self.worker_timeout_seconds = worker_timeout_seconds
+
+        # Ensure storage directory exists
+        storage_dir = os.path.dirname(storage_path)
+        if storage_dir:
+            Path(storage_dir).mkdir(parents=True, exist_ok=True)
+
+        self.storage = create_storage_backend(
+            storage_backend, storage_path, snapshot_interval, fsync, background_persistence
+        )
+        self.metrics = metrics or MetricsRegistry()
+        self._register_metrics()
+        self.lock = ReentrantLock(
+            on_wait=lambda seconds: self._lock_wait_seconds.observe(seconds, lock="store"),
+            on_release=self._publish
+        )
+        self.history_lock = ReentrantLock(
+            on_wait=lambda seconds: self._lock_wait_seconds.observe(seconds, lock="history")
+        )
         self.context = {
             "project_id": None,
             "project_name": None,
@@ -61,7 +311,6 @@ class ContextStore:
             "plan": {},
             "tasks": {},
             "workers": {},
-            "conversation_history": [],
             "metrics": {
                 "total_tasks": 0,
                 "completed_tasks": 0,
@@ -71,28 +320,980 @@ class ContextStore:
             }
         }
 
-        # Ensure storage directory exists
-        storage_dir = os.path.dirname(storage_path)
-        if storage_dir:
-            Path(storage_dir).mkdir(parents=True, exist_ok=True)
+        # Dispatch indexes (derived from context, never persisted)
+        self._unmet_deps: Dict[str, int] = {}
+        self._dependents: Dict[str, List[str]] = {}
+        self._ready: Dict[str, Tuple[float, int]] = {}
+        self._ready_by_capability: Dict[str, List[Tuple[Tuple[float, int], str]]] = {}
+        self._tasks_by_status: Dict[str, Set[str]] = {}
+        self._task_order: Dict[str, int] = {}
+        self._lease_heap: List[Tuple[float, str]] = []
+
+        # Journal records deferred by an open transaction, keyed by entity
+        self._transaction_depth = 0
+        self._pending_records: Dict[Tuple[str, Any], dict] = {}
+
+        # Parked long-poll claimers, in arrival order
+        self._waiters: Dict[str, Dict[asyncio.Future, None]] = {}
+        self._all_waiters: Dict[asyncio.Future, Tuple[str, List[str]]] = {}
+
+        # When each ready task became ready (bounds how long it may be deferred)
+        self._ready_since: Dict[str, float] = {}
+
+        # Per-worker utilization: [leased task count, busy since, busy seconds, first seen]
+        self._utilization: Dict[str, List[float]] = {}
+
+        # Last heartbeat (monotonic) per worker that has sent one
+        self._heartbeats: Dict[str, float] = {}
+
+        # Status versioning: change log of (version, entity) and parked status pollers;
+        # versions are not persisted, so the epoch tells readers which run they belong to
+        self.epoch = uuid.uuid4().hex[:16]
+        self.version = 0
+        self._changes: "deque[Tuple[int, Tuple[str, Optional[str]]]]" = deque(maxlen=change_log_size)
+        self._status_waiters: Dict[asyncio.Future, None] = {}
+        self._workers_by_status: Dict[str, int] = {}
+
+        # Task events (not persisted; seq restarts at 0) and parked event waiters
+        self.event_seq = 0
+        self._events: "deque[dict]" = deque(maxlen=event_log_size)
+        self._event_waiters: Dict[asyncio.Future, None] = {}
+        self._woken_event_seq = 0
+
+        # Claim times of leased tasks and smoothed completion time per capability
+        self._claimed_at: Dict[str, float] = {}
+        self._task_seconds: Dict[str, float] = {}
+
+        # Critical-path scheduling: upward rank per task and makespan tracking;
+        # tasks whose rank (and their ancestors') needs settling, and whether
+        # the duration model moved since the last full re-rank
+        self._rank: Dict[str, float] = {}
+        self._rank_dirty: Set[str] = set()
+        self._ranks_recalibrated = False
+        self._last_rank_refresh = 0.0
+        self._durations = DurationModel()
+        self._predicted_makespan: Optional[float] = None
+        self._execution_started: Optional[float] = None
+        self._execution_finished: Optional[float] = None
+
+        # Read view: copies of tasks and workers as of the last lock release
+        self._view_tasks: Dict[str, dict] = {}
+        self._view_workers: Dict[str, dict] = {}
+        self._view_status: Optional[dict] = None
+        self._view_version = -1
+
+        # Recent conversation in memory, the rest in <storage_path>.history/
+        self.history = ConversationHistory(
+            f"{storage_path}.history", history_memory_entries, history_segment_bytes
+        )
+
+        # Large results and artifacts out of line; live output of running tasks in memory
+        self.blobs = BlobStore(f"{storage_path}.blobs")
+        self.outputs = TaskOutputStreams(output_buffer_chars)
+
+        # Results of completed tasks by cache key, shared across projects
+        self.result_cache = ResultCache(f"{storage_path}.cache") if result_cache else None
 
         # Load existing context if available
-        if os.path.exists(storage_path):
-            self._load()
+        self._load()
 
     def _load(self):
-        """Load context from disk."""
-        try:
-            with open(self.storage_path, 'r') as f:
-                self.context = json.load(f)
-        except (json.JSONDecodeError, IOError) as e:
-            print(f"Warning: Could not load context from {self.storage_path}: {e}")
+        """Load persisted state and replay any journal tail."""
+        state, records = self.storage.load()
+
+        if state is not None:
+            self.history.restore(state.pop("conversation_history", []))
+            self.context.update(state)
+
+        for record in records:
+            self._apply(record)
+
+        self._rebuild_indexes()
+        self._publish()
+
+    def _rebuild_indexes(self):
+        """Rebuild all dispatch indexes from the task table."""
+        self._unmet_deps.clear()
+        self._dependents.clear()
+        self._ready.clear()
+        self._ready_by_capability.clear()
+        self._tasks_by_status.clear()
+        self._task_order.clear()
+        self._rank.clear()
+        self._rank_dirty.clear()
+        self._lease_heap.clear()
+
+        for task in self.context["tasks"].values():
+            self._index_task(task)
+            if task["status"] in LEASED_STATUSES and task.get("lease_expires_at"):
+                heapq.heappush(self._lease_heap, (task["lease_expires_at"], task["id"]))
+            if task["status"] in LEASED_STATUSES and task.get("assigned_to"):
+                self._worker_busy_start(task["assigned_to"])
+
+        self._workers_by_status.clear()
+        for worker in self.context["workers"].values():
+            self._count_worker(worker["status"], 1)
+
+    def _count_worker(self, status: str, delta: int):
+        """Adjust the per-status worker counters."""
+        count = self._workers_by_status.get(status, 0) + delta
+        if count:
+            self._workers_by_status[status] = count
+        else:
+            self._workers_by_status.pop(status, None)
+
+    def _mark_changed(self, op: str, payload: dict):
+        """
+        Bump the status version for a mutation that affects project status.
+
+        Args:
+            op: Mutation type, as passed to _record
+            payload: Mutation data, as passed to _record
+        """
+        if op == "task":
+            entity = ("task", payload["task"]["id"])
+        elif op == "worker":
+            entity = ("worker", payload["worker"]["id"])
+        elif op in ("project", "metrics"):
+            entity = (op, None)
+        else:
+            return
+
+        self.version += 1
+        self._changes.append((self.version, entity))
+
+        for waiter in self._status_waiters:
+            if not waiter.done():
+                waiter.set_result(self.version)
+        self._status_waiters.clear()
+
+    def _emit(self, event_type: str, **data):
+        """
+        Append a task event. Must be called while holding the lock.
+
+        Waiters are woken when the lock is released, so they never see an
+        event of an open transaction before its effects.
+
+        Args:
+            event_type: task_completed, task_failed or all_tasks_terminal
+            **data: Event details
+        """
+        self.event_seq += 1
+        self._events.append({
+            "seq": self.event_seq,
+            "type": event_type,
+            "time": datetime.utcnow().isoformat() + "Z",
+            **data
+        })
+
+    def _register_metrics(self):
+        """Create the store's metrics in the registry."""
+        self._lock_wait_seconds = self.metrics.histogram(
+            "mcp_store_lock_wait_seconds",
+            "Time spent waiting to acquire a context store lock",
+            ("lock",)
+        )
+        self._task_duration_seconds = self.metrics.histogram(
+            "mcp_task_duration_seconds",
+            "Time from claim to completion per required capability",
+            ("capability",),
+            buckets=(1, 5, 15, 30, 60, 120, 300, 600, 1800, 3600)
+        )
+        self._persist_seconds = self.metrics.histogram(
+            "mcp_store_persist_duration_seconds",
+            "Time spent encoding journal records and copying snapshot state under the lock",
+            ("kind",)
+        )
+        self._cache_lookups = self.metrics.counter(
+            "mcp_result_cache_lookups_total",
+            "Result cache lookups for claimed tasks",
+            ("outcome",)
+        )
+        self._partial_match_claims = self.metrics.counter(
+            "mcp_partial_match_claims_total",
+            "Tasks claimed by a worker below min_coverage after waiting max_defer_seconds"
+        )
+        self._cache_saved_seconds = self.metrics.counter(
+            "mcp_result_cache_saved_seconds_total",
+            "Execution time of the original runs of tasks served from the result cache"
+        )
+        self.metrics.callback(
+            "mcp_store_ready_tasks",
+            "Ready tasks per required capability",
+            self._ready_depth,
+            ("capability",)
+        )
+        self.metrics.callback(
+            "mcp_worker_busy_seconds_total",
+            "Time each worker has spent holding at least one task",
+            lambda: self._utilization_seconds()[0],
+            ("worker",),
+            metric_type="counter"
+        )
+        self.metrics.callback(
+            "mcp_worker_idle_seconds_total",
+            "Time each worker has spent without a task since it was first seen",
+            lambda: self._utilization_seconds()[1],
+            ("worker",),
+            metric_type="counter"
+        )
+
+    def _ready_depth(self) -> Dict[Tuple[str, ...], float]:
+        """Count ready tasks per capability bucket (scrape-time)."""
+        depth: Dict[Tuple[str, ...], float] = {}
+        tasks = self.context["tasks"]
+        for task_id in list(self._ready):
+            task = tasks.get(task_id)
+            if task is None:
+                continue
+            for cap in task.get("required_capabilities") or [ANY_CAPABILITY]:
+                depth[(cap,)] = depth.get((cap,), 0) + 1
+        return depth
+
+    def _utilization_seconds(self) -> Tuple[Dict[Tuple[str, ...], float], Dict[Tuple[str, ...], float]]:
+        """Busy and idle seconds per worker, including the current busy span."""
+        now = time.monotonic()
+        busy, idle = {}, {}
+        for worker_id, (active, busy_since, busy_total, first_seen) in list(self._utilization.items()):
+            total = busy_total + (now - busy_since if active else 0.0)
+            busy[(worker_id,)] = round(total, 3)
+            idle[(worker_id,)] = round(max(now - first_seen - total, 0.0), 3)
+        return busy, idle
+
+    def _worker_seen(self, worker_id: str) -> List[float]:
+        """Get a worker's utilization record, starting its clock on first sight."""
+        state = self._utilization.get(worker_id)
+        if state is None:
+            state = [0, 0.0, 0.0, time.monotonic()]
+            self._utilization[worker_id] = state
+        return state
+
+    def _worker_busy_start(self, worker_id: str):
+        """Account for a worker taking one more task."""
+        state = self._worker_seen(worker_id)
+        if state[0] == 0:
+            state[1] = time.monotonic()
+        state[0] += 1
+
+    def _worker_busy_end(self, worker_id: Optional[str]):
+        """Account for a worker letting go of one task."""
+        state = self._utilization.get(worker_id)
+        if state is None or state[0] == 0:
+            return
+        state[0] -= 1
+        if state[0] == 0:
+            state[2] += time.monotonic() - state[1]
+
+    def _index_task(self, task: dict):
+        """
+        Add a newly created task to the dispatch indexes.
+
+        Args:
+            task: Task record already present in context["tasks"]
+        """
+        task_id = task["id"]
+        tasks = self.context["tasks"]
+
+        self._task_order[task_id] = len(self._task_order)
+        self._tasks_by_status.setdefault(task["status"], set()).add(task_id)
+
+        unmet = 0
+        for dep in task.get("dependencies", []):
+            self._dependents.setdefault(dep, []).append(task_id)
+            if tasks.get(dep, {}).get("status") != TaskStatus.COMPLETED.value:
+                unmet += 1
+        self._unmet_deps[task_id] = unmet
+
+        # Provisional rank (tasks created earlier may already depend on this
+        # one); it and its ancestors are settled before ranks are next read
+        self._rank[task_id] = self._durations.cost(task) + max(
+            (self._rank.get(d, 0.0) for d in self._dependents.get(task_id, [])),
+            default=0.0
+        )
+        self._rank_dirty.add(task_id)
+        self._refresh_ready(task)
+
+    def _settle_ranks(self):
+        """
+        Bring upward ranks up to date and reorder the affected ready tasks.
+
+        Must be called while holding the lock. Tasks created since the last
+        call are re-ranked together with their ancestors (each visited
+        once, in one reverse-topological pass). After a recalibration of
+        the duration model, every unfinished task is re-ranked instead,
+        at most once per RANK_REFRESH_SECONDS.
+        """
+        tasks = self.context["tasks"]
+        now = time.monotonic()
+
+        if self._ranks_recalibrated and now - self._last_rank_refresh >= RANK_REFRESH_SECONDS:
+            self._ranks_recalibrated = False
+            self._last_rank_refresh = now
+            self._rank_dirty.clear()
+            completed = TaskStatus.COMPLETED.value
+            affected = {t: task for t, task in tasks.items() if task["status"] != completed}
+        elif self._rank_dirty:
+            affected = {}
+            stack = [t for t in self._rank_dirty if t in tasks]
+            self._rank_dirty.clear()
+            while stack:
+                current = stack.pop()
+                if current in affected:
+                    continue
+                affected[current] = tasks[current]
+                stack.extend(d for d in tasks[current].get("dependencies", []) if d in tasks and d not in affected)
+        else:
+            return
+
+        ranks = upward_ranks(affected, self._dependents, self._durations.cost, fixed=self._rank)
+        for task_id, rank in ranks.items():
+            if self._rank.get(task_id) != rank:
+                self._rank[task_id] = rank
+                if task_id in self._ready:
+                    self._refresh_ready(tasks[task_id])
+
+    def _ready_key(self, task: dict) -> Tuple[float, int]:
+        """Dispatch ordering key for a ready task (lower is dispatched first)."""
+        return (-round(self._rank.get(task["id"], 0.0), 6), self._task_order[task["id"]])
+
+    def _refresh_ready(self, task: dict):
+        """
+        Add or remove a task from the ready index to match its current state.
+
+        A task is ready when it is pending and all its dependencies are completed.
+        Removal is lazy: stale heap entries are discarded when they surface.
+
+        Args:
+            task: Task record
+        """
+        task_id = task["id"]
+        is_ready = (
+            task["status"] == TaskStatus.PENDING.value
+            and self._unmet_deps.get(task_id, 0) == 0
+        )
+
+        if not is_ready:
+            self._ready.pop(task_id, None)
+            self._ready_since.pop(task_id, None)
+            return
+
+        key = self._ready_key(task)
+        previous = self._ready.get(task_id)
+        if previous == key:
+            return
+
+        self._ready[task_id] = key
+        self._ready_since.setdefault(task_id, time.monotonic())
+        for cap in task.get("required_capabilities") or [ANY_CAPABILITY]:
+            heapq.heappush(self._ready_by_capability.setdefault(cap, []), (key, task_id))
+
+        # Only a task that just became ready claims a parked worker: a
+        # re-ranked one was already offered, and waking for it again would
+        # take a waiter from a task made ready in the same transaction
+        if previous is None:
+            self._wake_waiter(task)
+
+    def _parked_candidates(self, task: dict) -> Dict[asyncio.Future, None]:
+        """Parked claimers, in arrival order, that are eligible for a task."""
+        capabilities = task.get("required_capabilities")
+
+        if not capabilities:
+            return self._all_waiters
+
+        candidates = {}
+        for cap in capabilities:
+            candidates.update(self._waiters.get(cap, {}))
+        return candidates
+
+    def _fit(self, task: dict, worker_id: str, worker_capabilities: List[str]) -> float:
+        """Fit score of a worker for a task."""
+        return self.matcher.score(
+            task,
+            worker_id,
+            worker_capabilities,
+            self.context["workers"].get(worker_id),
+            self.context["tasks"]
+        )
+
+    def _covers(self, task: dict, worker_capabilities: List[str]) -> bool:
+        """Check whether a worker has at least min_coverage of a task's required capabilities."""
+        return self.matcher.coverage(task, worker_capabilities) >= self.min_coverage - 1e-9
 
-    async def _save(self):
-        """Save context to disk."""
+    def _claimable(self, task_id: str, worker_capabilities: List[str], now: float) -> bool:
+        """Check whether a worker may claim a ready task: it covers it, or the task waited max_defer_seconds."""
+        return (
+            self._covers(self.context["tasks"][task_id], worker_capabilities)
+            or now - self._ready_since.get(task_id, now) >= self.max_defer_seconds
+        )
+
+    def _wake_waiter(self, task: dict):
+        """
+        Wake the parked claimer that fits a newly ready task best.
+
+        Only claimers that cover the task are considered; the task has
+        not waited yet, so a partial match couldn't claim it. Each call
+        wakes a different waiter (woken ones are skipped until they
+        claim and unpark), so when several tasks become ready in one
+        transaction, one waiter is woken per task. Ties go to the
+        longest-parked claimer.
+
+        Args:
+            task: Task that just became ready
+        """
+        best, best_fit = None, None
+        for waiter in self._parked_candidates(task):
+            if waiter.done():
+                continue
+            worker_id, worker_capabilities = self._all_waiters[waiter]
+            if not self._covers(task, worker_capabilities):
+                continue
+            fit = self._fit(task, worker_id, worker_capabilities)
+            if best is None or fit > best_fit:
+                best, best_fit = waiter, fit
+
+        if best is not None:
+            best.set_result(task["id"])
+
+    def _park_waiter(self, worker_id: str, worker_capabilities: List[str]) -> asyncio.Future:
+        """Register a long-poll waiter for a worker and its capabilities."""
+        waiter = asyncio.get_running_loop().create_future()
+        self._all_waiters[waiter] = (worker_id, worker_capabilities)
+        for cap in worker_capabilities:
+            self._waiters.setdefault(cap, {})[waiter] = None
+        return waiter
+
+    def _unpark_waiter(self, waiter: asyncio.Future, worker_capabilities: List[str]):
+        """Remove a long-poll waiter from every index it was parked in."""
+        self._all_waiters.pop(waiter, None)
+        for cap in worker_capabilities:
+            self._waiters.get(cap, {}).pop(waiter, None)
+
+    def _set_task_status(self, task: dict, status: str):
+        """
+        Change a task's status and update the dispatch indexes.
+
+        Only direct dependents are touched when the task enters or
+        leaves the completed state.
+
+        Args:
+            task: Task record
+            status: New status value
+        """
+        task_id = task["id"]
+        old_status = task["status"]
+        task["status"] = status
+
+        if old_status == status:
+            return
+
+        self._tasks_by_status.get(old_status, set()).discard(task_id)
+        self._tasks_by_status.setdefault(status, set()).add(task_id)
+
+        completed = TaskStatus.COMPLETED.value
+        if completed in (old_status, status):
+            delta = -1 if status == completed else 1
+            tasks = self.context["tasks"]
+            for dependent_id in self._dependents.get(task_id, []):
+                self._unmet_deps[dependent_id] += delta
+                if dependent_id in tasks:
+                    self._refresh_ready(tasks[dependent_id])
+
+        self._refresh_ready(task)
+
+    def _next_ready_task_id(self, worker_capabilities: List[str]) -> Optional[str]:
+        """
+        Find the highest-priority ready task a worker may claim.
+
+        Args:
+            worker_capabilities: List of worker capabilities
+
+        Returns:
+            Task ID or None if nothing is ready
+        """
+        now = time.monotonic()
+        candidates = self._top_ready(
+            worker_capabilities, 1, lambda task_id: self._claimable(task_id, worker_capabilities, now)
+        )
+        return candidates[0] if candidates else None
+
+    def _partial_match_delay(self, worker_capabilities: List[str]) -> Optional[float]:
+        """
+        Seconds until a ready task the worker only partly covers may go to it.
+
+        Must be called while holding the lock.
+
+        Args:
+            worker_capabilities: List of worker capabilities
+
+        Returns:
+            Delay, or None if no such task is among the worker's candidates
+        """
+        tasks = self.context["tasks"]
+        now = time.monotonic()
+        partial = self._top_ready(
+            worker_capabilities, self.match_candidates,
+            lambda task_id: not self._covers(tasks[task_id], worker_capabilities)
+        )
+        delays = [self._ready_since.get(task_id, now) + self.max_defer_seconds - now for task_id in partial]
+        return max(min(delays), 0.01) if delays else None
+
+    def _top_ready(
+        self,
+        worker_capabilities: List[str],
+        limit: int,
+        accept: Optional[Callable[[str], bool]] = None
+    ) -> List[str]:
+        """
+        Collect the highest-priority ready tasks a worker is eligible for.
+
+        Args:
+            worker_capabilities: List of worker capabilities
+            limit: Maximum number of tasks per capability bucket
+            accept: Keep only tasks it returns True for (the rest don't count toward limit)
+
+        Returns:
+            Task ids in dispatch order
+        """
+        found = {}
+        for cap in [ANY_CAPABILITY, *worker_capabilities]:
+            heap = self._ready_by_capability.get(cap)
+            taken, skipped = [], []
+            while heap and len(taken) < limit:
+                key, task_id = heapq.heappop(heap)
+                if self._ready.get(task_id) != key:
+                    continue
+                (taken if accept is None or accept(task_id) else skipped).append((key, task_id))
+            for entry in skipped:
+                heapq.heappush(heap, entry)
+            for entry in taken:
+                heapq.heappush(heap, entry)
+                found[entry[1]] = entry[0]
+
+        return sorted(found, key=found.get)[:limit]
+
+    def _choose_task(self, worker_id: str, worker_capabilities: List[str]) -> Optional[str]:
+        """
+        Pick the ready task a worker should claim.
+
+        Candidates are the top match_candidates ready tasks by priority.
+        Each is scored by fit plus its rank relative to the best candidate,
+        so critical-path tasks still lead. Until a task has waited
+        max_defer_seconds, it is skipped if the worker is below
+        min_coverage for it, or if a parked worker that covers it fits it
+        better (that worker is woken for it).
+
+        Args:
+            worker_id: Claiming worker
+            worker_capabilities: List of worker capabilities
+
+        Returns:
+            Task ID or None if nothing suitable is ready
+        """
+        self._settle_ranks()
+        now = time.monotonic()
+        candidates = self._top_ready(
+            worker_capabilities, self.match_candidates,
+            lambda task_id: self._claimable(task_id, worker_capabilities, now)
+        )
+        if not candidates:
+            return None
+
+        tasks = self.context["tasks"]
+        top_rank = max(self._rank.get(t, 0.0) for t in candidates) or 1.0
+
+        best, best_score = None, None
+        for task_id in candidates:
+            task = tasks[task_id]
+            fit = self._fit(task, worker_id, worker_capabilities)
+
+            if now - self._ready_since.get(task_id, now) < self.max_defer_seconds:
+                better_parked = next((
+                    waiter for waiter in self._parked_candidates(task)
+                    if not waiter.done()
+                    and self._all_waiters[waiter][0] != worker_id
+                    and self._covers(task, self._all_waiters[waiter][1])
+                    and self._fit(task, *self._all_waiters[waiter]) > fit + 1e-9
+                ), None)
+                if better_parked is not None:
+                    # Make sure the better worker comes for it
+                    better_parked.set_result(task_id)
+                    continue
+
+            score = fit + self.priority_weight * self._rank.get(task_id, 0.0) / top_rank
+            if best is None or score > best_score:
+                best, best_score = task_id, score
+
+        if best is not None and not self._covers(tasks[best], worker_capabilities):
+            self._partial_match_claims.inc()
+        return best
+
+    def _assign(self, task: dict, worker_id: str, lease: bool = False):
+        """
+        Assign a task to a worker. Must be called while holding the lock.
+
+        Args:
+            task: Task record
+            worker_id: Worker taking the task
+            lease: Put the assignment under a renewable lease
+        """
+        now = datetime.utcnow().isoformat() + "Z"
+        if task["status"] in LEASED_STATUSES:
+            self._worker_busy_end(task.get("assigned_to"))
+        self._worker_busy_start(worker_id)
+        self._claimed_at[task["id"]] = time.monotonic()
+
+        if self._execution_started is None:
+            self._settle_ranks()
+            self._execution_started = time.time()
+            self._predicted_makespan = max(self._rank.values(), default=0.0)
+        self._set_task_status(task, TaskStatus.ASSIGNED.value)
+        task.update({
+            "assigned_to": worker_id,
+            "assigned_at": now,
+            "updated_at": now,
+            "claims": task.get("claims", 0) + 1
+        })
+        # Output of an earlier claim (reclaimed or retried) is stale now
+        self.outputs.reset(task["id"], task["claims"])
+
+        if lease:
+            self._renew_lease(task)
+
+        self._record("task", task=task)
+
+        worker = self.context["workers"].get(worker_id)
+        if worker is not None:
+            worker.setdefault("current_tasks", []).append(task["id"])
+            self._record("worker", worker=worker)
+
+    def _renew_lease(self, task: dict):
+        """Extend a task's lease by lease_seconds from now."""
+        expires_at = time.time() + self.lease_seconds
+        task["lease_expires_at"] = expires_at
+        heapq.heappush(self._lease_heap, (expires_at, task["id"]))
+
+    def _release(self, task: dict):
+        """
+        Detach a task from its worker and drop its lease.
+
+        Args:
+            task: Task record leaving a leased status
+        """
+        task.pop("lease_expires_at", None)
+        self._claimed_at.pop(task["id"], None)
+        self._worker_busy_end(task.get("assigned_to"))
+
+        worker = self.context["workers"].get(task.get("assigned_to"))
+        if worker is not None and task["id"] in worker.get("current_tasks", []):
+            worker["current_tasks"].remove(task["id"])
+            self._record("worker", worker=worker)
+
+    def _observe_duration(self, task: dict) -> Optional[float]:
+        """
+        Record how long a completed task took since it was claimed.
+
+        Updates the per-capability histogram, an exponentially smoothed
+        average used as a scaling signal, and the duration model behind
+        the upward ranks.
+
+        Args:
+            task: Task record about to leave a leased status as completed
+
+        Returns:
+            Seconds since the claim, or None if the claim time is unknown
+        """
+        claimed_at = self._claimed_at.get(task["id"])
+        if claimed_at is None:
+            return None
+
+        seconds = time.monotonic() - claimed_at
+        for cap in task.get("required_capabilities") or [ANY_CAPABILITY]:
+            self._task_duration_seconds.observe(seconds, capability=cap)
+            previous = self._task_seconds.get(cap)
+            self._task_seconds[cap] = seconds if previous is None else 0.7 * previous + 0.3 * seconds
+
+        change = self._durations.observe(
+            task.get("required_capabilities") or [],
+            task.get("estimated_hours", 0),
+            seconds
+        )
+        # Re-rank (rate-limited, on the next settle) only when the calibration moved noticeably
+        if change > 0.05:
+            self._ranks_recalibrated = True
+        return seconds
+
+    def _trace_claim(self, task: dict):
+        """
+        Record the spans a task spent waiting, just before it is claimed.
+
+        Must be called while holding the lock, while the task is still ready.
+
+        Args:
+            task: Task record about to be assigned
+        """
+        trace = task.get("trace")
+        if trace is None:
+            return
+
+        now = time.time()
+        # Ready times are monotonic; place them on the wall clock
+        ready_at = now - (time.monotonic() - self._ready_since.get(task["id"], time.monotonic()))
+        attempt = task.get("attempts", 0)
+
+        if self.tracer is not None:
+            if "claimed" not in trace:
+                self.tracer.record(
+                    "task.blocked", trace["trace_id"], new_span_id(), trace["span_id"],
+                    trace["created"], max(0.0, ready_at - trace["created"]),
+                    task_id=task["id"]
+                )
+            self.tracer.record(
+                "task.queued", trace["trace_id"], new_span_id(), trace["span_id"],
+                ready_at, now - ready_at,
+                task_id=task["id"], attempt=attempt
+            )
+        trace["claimed"] = now
+
+    def _trace_finish(self, task: dict, status: str, cache_hit: bool):
+        """
+        Record the leased span and the root span of a task that completed or failed.
+
+        Must be called while holding the lock, while the task is still leased.
+
+        Args:
+            task: Task record
+            status: Terminal status it is moving to
+            cache_hit: The result came from the result cache
+        """
+        trace = task.get("trace")
+        if self.tracer is None or trace is None:
+            return
+
+        now = time.time()
+        attributes = {"task_id": task["id"], "status": status, "attempt": task.get("attempts", 0)}
+        if "claimed" in trace:
+            self.tracer.record(
+                "task.leased", trace["trace_id"], new_span_id(), trace["span_id"],
+                trace["claimed"], now - trace["claimed"],
+                worker_id=task.get("assigned_to"), cache_hit=cache_hit, **attributes
+            )
+        self.tracer.record(
+            "task", trace["trace_id"], trace["span_id"], trace.get("parent_id"),
+            trace["created"], now - trace["created"],
+            dependencies=task.get("dependencies", []), **attributes
+        )
+
+    def _cache_key(self, task: dict, worker_id: str) -> Optional[str]:
+        """
+        Result cache key of a task about to be run by a worker.
+
+        Tasks created with "cache": false are never cached.
+
+        Args:
+            task: Task record whose dependencies have completed
+            worker_id: Worker claiming the task
+
+        Returns:
+            Key, or None if the task isn't cacheable
+        """
+        if self.result_cache is None or not task.get("cache", True):
+            return None
+        tasks = self.context["tasks"]
+        dependency_results = [
+            tasks[dep_id].get("result") if dep_id in tasks else None
+            for dep_id in task.get("dependencies", [])
+        ]
+        model = (self.context["workers"].get(worker_id) or {}).get("model")
+        return task_cache_key(task, dependency_results, model)
+
+    def _reclaim_expired_leases(self) -> int:
+        """
+        Return tasks whose lease has expired to the ready queue.
+
+        Returns:
+            Number of tasks reclaimed
+        """
+        now = time.time()
+        tasks = self.context["tasks"]
+        reclaimed = 0
+
+        while self._lease_heap and self._lease_heap[0][0] <= now:
+            expires_at, task_id = heapq.heappop(self._lease_heap)
+            task = tasks.get(task_id)
+            if (
+                task is None
+                or task["status"] not in LEASED_STATUSES
+                or task.get("lease_expires_at") != expires_at
+            ):
+                continue
+
+            self._release(task)
+            task.update({
+                "assigned_to": None,
+                "progress": 0,
+                "reclaimed_count": task.get("reclaimed_count", 0) + 1,
+                "updated_at": datetime.utcnow().isoformat() + "Z"
+            })
+            self._set_task_status(task, TaskStatus.PENDING.value)
+            self._record("task", task=task)
+            reclaimed += 1
+
+        return reclaimed
+
+    def _apply(self, record: dict):
+        """
+        Apply a journal record to the in-memory context.
+
+        Args:
+            record: Mutation record produced by _record
+        """
+        op = record["op"]
+
+        if op == "project":
+            self.context.update(record["fields"])
+        elif op == "plan":
+            self.context["plan"] = record["plan"]
+        elif op == "task":
+            self.context["tasks"][record["task"]["id"]] = record["task"]
+        elif op == "worker":
+            self.context["workers"][record["worker"]["id"]] = record["worker"]
+        elif op == "metrics":
+            self.context["metrics"] = record["metrics"]
+        elif op == "conversation":
+            self.history.append(record["entry"])
+
+    def _record(self, op: str, **payload):
+        """
+        Persist a single mutation. Must be called while holding the lock.
+
+        Inside a transaction the record is deferred until commit, and
+        repeated records for the same entity collapse into the latest.
+
+        Args:
+            op: Mutation type (project, plan, task, worker, metrics, conversation)
+            **payload: Mutation data, as expected by _apply
+        """
+        record = {"op": op, **payload}
+        self._mark_changed(op, payload)
+
+        if self._transaction_depth and self.lock.held_by_current_task():
+            if op == "task":
+                key = (op, payload["task"]["id"])
+            elif op == "worker":
+                key = (op, payload["worker"]["id"])
+            elif op in ("plan", "metrics"):
+                key = (op, None)
+            else:
+                key = (op, len(self._pending_records))
+            self._pending_records.pop(key, None)
+            self._pending_records[key] = record
+            return
+
+        self._write_records([record])
+
+    def _write_records(self, records: List[dict]):
+        """
+        Append records to the journal, compacting when due. Must be called while holding the lock.
+
+        Args:
+            records: Mutation records, in order
+        """
+        started = time.perf_counter()
+        compaction_due = self.storage.append_batch(records)
+        self._persist_seconds.observe(time.perf_counter() - started, kind="journal")
+
+        if compaction_due:
+            self._save()
+
+    @contextlib.asynccontextmanager
+    async def transaction(self):
+        """
+        Run several store operations under one lock hold with one journal flush.
+
+        Holds the store lock for the whole block, so no other coroutine
+        observes intermediate state. There is no rollback: records are
+        written when the outermost transaction exits, even if the block
+        raised, so operations that completed before an error stand.
+        """
         async with self.lock:
-            with open(self.storage_path, 'w') as f:
-                json.dump(self.context, f, indent=2)
+            self._transaction_depth += 1
+            try:
+                yield self
+            finally:
+                self._transaction_depth -= 1
+                if self._transaction_depth == 0 and self._pending_records:
+                    records = list(self._pending_records.values())
+                    self._pending_records.clear()
+                    self._write_records(records)
+
+    def _save(self):
+        """
+        Compact the journal into a full snapshot. Must be called while holding the lock.
+
+        Only a copy of the state is taken here; it is encoded and written
+        on the storage writer thread. Backends that store tasks and workers
+        as they change get a snapshot without them.
+        """
+        started = time.perf_counter()
+        state = {
+            key: _copy_value(value) for key, value in self.context.items()
+            if key not in ("tasks", "workers", "conversation_history")
+        }
+        state["conversation_history"] = list(self.history.recent)
+        if self.storage.full_snapshots:
+            state["tasks"] = {task_id: _copy_entity(task) for task_id, task in self.context["tasks"].items()}
+            state["workers"] = {
+                worker_id: _copy_entity(worker) for worker_id, worker in self.context["workers"].items()
+            }
+        self.storage.snapshot(state)
+        self._persist_seconds.observe(time.perf_counter() - started, kind="snapshot")
+
+    def _publish(self):
+        """Refresh the read view with what changed since the last release, and wake event waiters. Called as the store lock is released."""
+        if self._woken_event_seq != self.event_seq:
+            self._woken_event_seq = self.event_seq
+            for waiter in self._event_waiters:
+                if not waiter.done():
+                    waiter.set_result(self.event_seq)
+            self._event_waiters.clear()
+
+        if self._view_version == self.version:
+            return
+
+        tasks = self.context["tasks"]
+        workers = self.context["workers"]
+        oldest = self._changes[0][0] if self._changes else self.version + 1
+
+        if self._view_version < oldest - 1:
+            self._view_tasks = {task_id: _copy_entity(task) for task_id, task in tasks.items()}
+            self._view_workers = {worker_id: _copy_entity(worker) for worker_id, worker in workers.items()}
+        else:
+            for version, (kind, entity_id) in reversed(self._changes):
+                if version <= self._view_version:
+                    break
+                if kind == "task" and entity_id in tasks:
+                    self._view_tasks[entity_id] = _copy_entity(tasks[entity_id])
+                elif kind == "worker" and entity_id in workers:
+                    self._view_workers[entity_id] = _copy_entity(workers[entity_id])
+
+        status = self._status()
+        status["metrics"] = dict(status["metrics"])
+        self._view_status = status
+        self._view_version = self.version
+
+    async def flush(self):
+        """
+        Wait until every mutation so far has been written to disk.
+
+        Runs outside the store lock; concurrent callers share one write
+        (and fsync, when enabled).
+        """
+        await asyncio.wrap_future(self.storage.flush())
+
+    def close(self):
+        """Write outstanding journal records and close the store's files."""
+        self.storage.close()
+        self.history.close()
 
     async def initialize_project(self, project_id: str, project_name: str, requirements: str):
         """Initialize a new project."""
@@ -107,15 +1308,18 @@ class ContextStore:
                     "start_time": datetime.utcnow().isoformat() + "Z"
                 }
             })
-        await self._save()
+            self._record("project", fields={
+                key: self.context[key]
+                for key in ("project_id", "project_name", "state", "requirements", "metrics")
+            })
 
     async def set_plan(self, plan: dict):
         """Set the project plan."""
         async with self.lock:
             self.context["plan"] = plan
-        await self._save()
+            self._record("plan", plan=plan)
 
-    async def create_task(self, task_id: str, task_data: dict) -> dict:
+    async def create_task(self, task_id: str, task_data: dict) -> Optional[dict]:
         """
         Create a new task.
 
@@ -124,8 +1328,10 @@ class ContextStore:
             task_data: Task details (description, dependencies, etc.)
 
         Returns:
-            Created task dictionary
+            Created task dictionary, or None if a task with this id
+            already exists (it is left unchanged)
         """
+        parent = current_span()
         task = {
             "id": task_id,
             "status": TaskStatus.PENDING.value,
@@ -133,13 +1339,25 @@ class ContextStore:
             "progress": 0,
             "created_at": datetime.utcnow().isoformat() + "Z",
             "updated_at": datetime.utcnow().isoformat() + "Z",
+            "trace": {
+                "trace_id": parent[0] if parent else new_trace_id(),
+                "span_id": new_span_id(),
+                "parent_id": parent[1] if parent else None,
+                "created": time.time()
+            },
             **task_data
         }
 
         async with self.lock:
+            if task_id in self.context["tasks"]:
+                return None
+
             self.context["tasks"][task_id] = task
+            self._index_task(task)
+            self._execution_finished = None
             self.context["metrics"]["total_tasks"] += 1
-        await self._save()
+            self._record("task", task=task)
+            self._record("metrics", metrics=self.context["metrics"])
 
         return task
 
@@ -149,34 +1367,135 @@ class ContextStore:
             if task_id not in self.context["tasks"]:
                 return False
 
-            self.context["tasks"][task_id].update({
-                "status": TaskStatus.ASSIGNED.value,
-                "assigned_to": worker_id,
-                "updated_at": datetime.utcnow().isoformat() + "Z"
-            })
-
-            if worker_id in self.context["workers"]:
-                if "current_tasks" not in self.context["workers"][worker_id]:
-                    self.context["workers"][worker_id]["current_tasks"] = []
-                self.context["workers"][worker_id]["current_tasks"].append(task_id)
+            self._assign(self.context["tasks"][task_id], worker_id)
 
-        await self._save()
         return True
 
+    async def claim_next_task(
+        self,
+        worker_id: str,
+        worker_capabilities: List[str],
+        wait_seconds: float = 0
+    ) -> Optional[dict]:
+        """
+        Atomically pick the next ready task for a worker and lease it.
+
+        Expired leases are reclaimed first, so tasks held by stuck
+        workers are handed out again. If nothing is ready, the call
+        parks for up to wait_seconds until a matching task appears.
+
+        Args:
+            worker_id: Worker claiming the task
+            worker_capabilities: List of worker capabilities
+            wait_seconds: Maximum time to wait for a task (0 = don't wait)
+
+        Returns:
+            Copy of the claimed task, or None if nothing became ready
+        """
+        loop = asyncio.get_running_loop()
+        deadline = loop.time() + wait_seconds
+
+        while True:
+            async with self.lock:
+                self._reclaim_expired_leases()
+
+                task_id = self._choose_task(worker_id, worker_capabilities)
+                if task_id is not None:
+                    task = self.context["tasks"][task_id]
+                    task["cache_key"] = self._cache_key(task, worker_id)
+                    self._trace_claim(task)
+                    self._assign(task, worker_id, lease=True)
+                    return {**task, "lease_seconds": self.lease_seconds}
+
+                remaining = deadline - loop.time()
+                if remaining <= 0:
+                    return None
+
+                # Parking inside a transaction would stall everyone else
+                if self._transaction_depth:
+                    return None
+
+                # Also wake up when the next lease expires, since that may free a
+                # task, and when a partly covered task may fall back to this worker
+                if self._lease_heap:
+                    remaining = min(remaining, max(self._lease_heap[0][0] - time.time(), 0.01))
+                fallback = self._partial_match_delay(worker_capabilities)
+                if fallback is not None:
+                    remaining = min(remaining, fallback)
+
+                waiter = self._park_waiter(worker_id, worker_capabilities)
+
+            try:
+                await asyncio.wait_for(waiter, timeout=remaining)
+            except asyncio.TimeoutError:
+                pass
+            finally:
+                self._unpark_waiter(waiter, worker_capabilities)
+
     async def update_task_status(
         self,
         task_id: str,
         status: str,
         progress: Optional[int] = None,
-        result: Optional[dict] = None
+        result: Optional[dict] = None,
+        worker_id: Optional[str] = None,
+        cache_hit: bool = False
     ) -> bool:
-        """Update task status and progress."""
+        """
+        Update task status and progress.
+
+        An update from the worker holding the task renews its lease.
+        Updates sent by a worker are rejected unless that worker holds the
+        task right now: its lease was reclaimed, or the task was already
+        completed or failed (e.g. a late progress update racing the
+        completion).
+
+        Args:
+            task_id: Task identifier
+            status: New status value
+            progress: Optional progress percentage
+            result: Optional result payload
+            worker_id: Worker sending the update, if any
+            cache_hit: The result came from the result cache (its duration
+                says nothing about how long the task takes)
+
+        Returns:
+            True if the update was applied
+
+        Raises:
+            ValueError: If status is not a task status
+        """
+        if status not in TASK_STATUS_VALUES:
+            raise ValueError(f"Invalid task status: {status}. Must be one of {sorted(TASK_STATUS_VALUES)}")
+
         async with self.lock:
             if task_id not in self.context["tasks"]:
                 return False
 
             task = self.context["tasks"][task_id]
-            task["status"] = status
+            if worker_id is not None and (
+                task["status"] not in LEASED_STATUSES or task.get("assigned_to") != worker_id
+            ):
+                return False
+
+            previous_status = task["status"]
+
+            if status in LEASED_STATUSES:
+                if "lease_expires_at" in task:
+                    self._renew_lease(task)
+            elif task["status"] in LEASED_STATUSES:
+                if status == TaskStatus.COMPLETED.value and not cache_hit:
+                    seconds = self._observe_duration(task)
+                    if seconds is not None:
+                        task["execution_seconds"] = round(seconds, 3)
+                if status in (TaskStatus.COMPLETED.value, TaskStatus.FAILED.value):
+                    self._trace_finish(task, status, cache_hit)
+                self._release(task)
+
+            if cache_hit:
+                task["cache_hit"] = True
+
+            self._set_task_status(task, status)
             task["updated_at"] = datetime.utcnow().isoformat() + "Z"
 
             if progress is not None:
@@ -185,15 +1504,130 @@ class ContextStore:
             if result is not None:
                 task["result"] = result
 
+            self._record("task", task=task)
+
             # Update metrics
-            if status == TaskStatus.COMPLETED.value:
+            if status in (TaskStatus.COMPLETED.value, TaskStatus.FAILED.value) and status != previous_status:
+                worker = self.context["workers"].get(task.get("assigned_to")) or {}
+                self.matcher.record_outcome(worker.get("worker_type"), status == TaskStatus.COMPLETED.value)
+
+            if status == previous_status:
+                pass
+            elif status == TaskStatus.COMPLETED.value:
                 self.context["metrics"]["completed_tasks"] += 1
+                self._record("metrics", metrics=self.context["metrics"])
             elif status == TaskStatus.FAILED.value:
                 self.context["metrics"]["failed_tasks"] += 1
+                self._record("metrics", metrics=self.context["metrics"])
+
+            if status in (TaskStatus.COMPLETED.value, TaskStatus.FAILED.value) and status != previous_status:
+                self._emit(
+                    f"task_{status}",
+                    task_id=task_id,
+                    worker_id=task.get("assigned_to"),
+                    attempts=task.get("attempts", 0),
+                    error=(result or {}).get("error") if status == TaskStatus.FAILED.value else None
+                )
+
+                if not self._unfinished_count():
+                    metrics = self.context["metrics"]
+                    self._emit(
+                        "all_tasks_terminal",
+                        total_tasks=metrics["total_tasks"],
+                        completed_tasks=metrics["completed_tasks"],
+                        failed_tasks=metrics["failed_tasks"]
+                    )
+
+            if self._execution_started is not None and not self._unfinished_count():
+                self._execution_finished = time.time()
 
-        await self._save()
         return True
 
+    async def retry_task(self, task_id: str) -> bool:
+        """
+        Put a failed task back in the ready queue.
+
+        The task no longer counts as failed, its attempts count is
+        incremented and its output stream is reopened (emptied), so
+        tailers wait for the retried attempt's output instead of seeing
+        the failed attempt's stream closed.
+
+        Args:
+            task_id: Failed task
+
+        Returns:
+            True if the task was failed and is pending again
+        """
+        async with self.lock:
+            task = self.context["tasks"].get(task_id)
+            if task is None or task["status"] != TaskStatus.FAILED.value:
+                return False
+
+            task["attempts"] = task.get("attempts", 0) + 1
+            task["assigned_to"] = None
+            task["progress"] = 0
+            task.pop("result", None)
+            task["updated_at"] = datetime.utcnow().isoformat() + "Z"
+            self._set_task_status(task, TaskStatus.PENDING.value)
+            self._execution_finished = None
+            self._record("task", task=task)
+            self.outputs.reset(task_id, task.get("claims", 0))
+
+            self.context["metrics"]["failed_tasks"] -= 1
+            self._record("metrics", metrics=self.context["metrics"])
+
+        return True
+
+    async def wait_for_events(self, after: int = 0, wait_seconds: float = 0, limit: int = 500) -> dict:
+        """
+        Get task events after a sequence number, long-polling if there are none yet.
+
+        Args:
+            after: Last event seq the caller has seen
+            wait_seconds: Maximum time to wait for an event (0 = don't wait)
+            limit: Maximum events returned
+
+        Returns:
+            Dictionary with events (oldest first), next (pass back as after)
+            and reset (events after the cursor were dropped or the store
+            restarted; re-check the full status)
+        """
+        loop = asyncio.get_running_loop()
+        deadline = loop.time() + wait_seconds
+
+        # Only events whose lock release has happened are visible
+        while self._woken_event_seq <= after and after <= self.event_seq:
+            remaining = deadline - loop.time()
+            if remaining <= 0:
+                break
+            waiter = loop.create_future()
+            self._event_waiters[waiter] = None
+            try:
+                await asyncio.wait_for(waiter, timeout=remaining)
+            except asyncio.TimeoutError:
+                pass
+            finally:
+                self._event_waiters.pop(waiter, None)
+
+        oldest = self._events[0]["seq"] if self._events else self.event_seq + 1
+        reset = after > self.event_seq or after < oldest - 1
+        visible = self._woken_event_seq
+        events = [event for event in self._events if after < event["seq"] <= visible][:limit]
+
+        return {
+            "events": events,
+            "next": events[-1]["seq"] if events else (0 if after > self.event_seq else after),
+            "reset": reset
+        }
+
+    def _unfinished_count(self) -> int:
+        """Number of tasks that are neither completed nor failed."""
+        finished = (TaskStatus.COMPLETED.value, TaskStatus.FAILED.value)
+        return sum(
+            len(task_ids) for status, task_ids in self._tasks_by_status.items()
+            if status not in finished
+        )
+
     async def register_worker(self, worker_id: str, worker_data: dict) -> dict:
         """Register a new worker."""
         worker = {
@@ -207,11 +1641,99 @@ class ContextStore:
         }
 
         async with self.lock:
+            previous = self.context["workers"].get(worker_id)
+            if previous is not None:
+                self._count_worker(previous["status"], -1)
+            self._count_worker(worker["status"], 1)
+
             self.context["workers"][worker_id] = worker
-        await self._save()
+            self._heartbeats[worker_id] = time.monotonic()
+            self._worker_seen(worker_id)
+            self._record("worker", worker=worker)
 
         return worker
 
+    async def heartbeat_worker(
+        self,
+        worker_id: str,
+        status: str,
+        current_tasks: Optional[List[str]] = None
+    ) -> Optional[dict]:
+        """
+        Record a worker heartbeat.
+
+        The worker record is only persisted when its status changes. Its
+        current_tasks stay owned by the store (claims and releases update
+        them under the lock); the worker's own list can lag behind a claim
+        in flight, so it is not applied.
+
+        Args:
+            worker_id: Worker sending the heartbeat
+            status: Worker's own status (a WorkerStatus value)
+            current_tasks: Task ids the worker reports running (diagnostic only)
+
+        Returns:
+            The worker record, or None if the worker is not registered
+
+        Raises:
+            ValueError: If status is not a WorkerStatus value
+        """
+        if status not in WORKER_STATUS_VALUES:
+            raise ValueError(f"Invalid worker status: {status}. Must be one of {sorted(WORKER_STATUS_VALUES)}")
+
+        async with self.lock:
+            worker = self.context["workers"].get(worker_id)
+            if worker is None:
+                return None
+
+            self._heartbeats[worker_id] = time.monotonic()
+            self._worker_seen(worker_id)
+
+            if worker["status"] != status:
+                self._count_worker(worker["status"], -1)
+                self._count_worker(status, 1)
+                worker["status"] = status
+                self._record("worker", worker=worker)
+
+            return worker
+
+    async def request_drain(self, worker_id: str) -> bool:
+        """
+        Ask a worker to stop taking tasks and exit once its tasks finish.
+
+        Args:
+            worker_id: Worker to drain
+
+        Returns:
+            False if the worker is not registered
+        """
+        async with self.lock:
+            worker = self.context["workers"].get(worker_id)
+            if worker is None:
+                return False
+
+            worker["drain_requested"] = True
+            self._record("worker", worker=worker)
+            return True
+
+    def _mark_silent_workers(self):
+        """
+        Mark workers whose heartbeats stopped as stopped. Must be called while holding the lock.
+        """
+        deadline = time.monotonic() - self.worker_timeout_seconds
+        for worker_id, last_seen in list(self._heartbeats.items()):
+            if last_seen >= deadline:
+                continue
+            del self._heartbeats[worker_id]
+
+            worker = self.context["workers"].get(worker_id)
+            if worker is None or worker["status"] == WorkerStatus.STOPPED.value:
+                continue
+            self._count_worker(worker["status"], -1)
+            self._count_worker(WorkerStatus.STOPPED.value, 1)
+            worker["status"] = WorkerStatus.STOPPED.value
+            self._record("worker", worker=worker)
+
     async def update_worker_status(self, worker_id: str, status: str, current_task: Optional[str] = None):
         """Update worker status."""
         async with self.lock:
@@ -219,102 +1741,385 @@ class ContextStore:
                 return False
 
             worker = self.context["workers"][worker_id]
+            self._count_worker(worker["status"], -1)
+            self._count_worker(status, 1)
             worker["status"] = status
 
             if current_task:
                 worker["current_task"] = current_task
 
-        await self._save()
+            self._record("worker", worker=worker)
+
         return True
 
     async def get_available_tasks(self, worker_capabilities: List[str]) -> List[dict]:
         """
         Get tasks available for assignment based on worker capabilities.
 
+        Tasks the worker covers below min_coverage are listed only once
+        they have waited max_defer_seconds.
+
         Args:
             worker_capabilities: List of worker capabilities
 
         Returns:
             List of available tasks
         """
-        available = []
-
         async with self.lock:
-            for task_id, task in self.context["tasks"].items():
-                if task["status"] == TaskStatus.PENDING.value:
-                    # Check if dependencies are met
-                    dependencies = task.get("dependencies", [])
-                    dependencies_met = all(
-                        self.context["tasks"].get(dep, {}).get("status") == TaskStatus.COMPLETED.value
-                        for dep in dependencies
-                    )
+            self._settle_ranks()
+            now = time.monotonic()
+            matched = {}
+            for cap in [ANY_CAPABILITY, *worker_capabilities]:
+                for key, task_id in self._ready_by_capability.get(cap, []):
+                    if self._ready.get(task_id) == key and self._claimable(task_id, worker_capabilities, now):
+                        matched[task_id] = key
 
-                    if dependencies_met:
-                        # Check capability match if required
-                        required_capabilities = task.get("required_capabilities", [])
-                        if not required_capabilities or any(
-                            cap in worker_capabilities for cap in required_capabilities
-                        ):
-                            available.append(task)
+            return [
+                self.context["tasks"][task_id]
+                for task_id in sorted(matched, key=matched.get)
+            ]
 
-        return available
+    async def get_next_available_task(self, worker_capabilities: List[str]) -> Optional[dict]:
+        """
+        Get the single best task available for a worker.
 
-    async def get_project_status(self) -> dict:
-        """Get full project status."""
+        Args:
+            worker_capabilities: List of worker capabilities
+
+        Returns:
+            Task dictionary or None if nothing is ready
+        """
         async with self.lock:
-            tasks_by_status = {}
-            for task in self.context["tasks"].values():
-                status = task["status"]
-                tasks_by_status[status] = tasks_by_status.get(status, 0) + 1
-
-            workers_by_status = {}
-            for worker in self.context["workers"].values():
-                status = worker["status"]
-                workers_by_status[status] = workers_by_status.get(status, 0) + 1
-
-            overall_progress = 0
-            if self.context["metrics"]["total_tasks"] > 0:
-                overall_progress = (
-                    self.context["metrics"]["completed_tasks"] /
-                    self.context["metrics"]["total_tasks"] * 100
-                )
+            self._settle_ranks()
+            task_id = self._next_ready_task_id(worker_capabilities)
+            return self.context["tasks"][task_id] if task_id else None
+
+    async def get_project_status(
+        self,
+        since: Optional[int] = None,
+        wait_seconds: float = 0,
+        epoch: Optional[str] = None
+    ) -> dict:
+        """
+        Get project status from incrementally maintained counters.
 
+        With since, the status also carries the tasks and workers changed
+        after that version. If the change log no longer reaches back that
+        far, or epoch isn't the store's (the version is from before a
+        restart), every task and worker is returned with reset set. With
+        wait_seconds the call long-polls until something changes after since.
+
+        Args:
+            since: Status version the caller already has
+            wait_seconds: Maximum time to wait for a change (0 = don't wait)
+            epoch: Status epoch since was read in (None = the current one)
+
+        Returns:
+            Status dictionary including the current version
+        """
+        # A full status doesn't wait for another task's open transaction
+        if since is None and self.lock.locked() and not self.lock.held_by_current_task():
+            return dict(self._view_status)
+
+        loop = asyncio.get_running_loop()
+        deadline = loop.time() + wait_seconds
+
+        while True:
+            async with self.lock:
+                self._mark_silent_workers()
+                remaining = deadline - loop.time()
+                if (
+                    since is None
+                    or since != self.version
+                    or (epoch is not None and epoch != self.epoch)
+                    or remaining <= 0
+                    or self._transaction_depth
+                ):
+                    return self._status(since, epoch)
+
+                waiter = loop.create_future()
+                self._status_waiters[waiter] = None
+
+            try:
+                await asyncio.wait_for(waiter, timeout=remaining)
+            except asyncio.TimeoutError:
+                pass
+            finally:
+                self._status_waiters.pop(waiter, None)
+
+    def _status(self, since: Optional[int] = None, epoch: Optional[str] = None) -> dict:
+        """
+        Build the status payload. Must be called while holding the lock.
+
+        Args:
+            since: Status version the caller already has, if any
+            epoch: Status epoch since belongs to, if known
+
+        Returns:
+            Status dictionary
+        """
+        metrics = self.context["metrics"]
+        overall_progress = 0
+        if metrics["total_tasks"] > 0:
+            overall_progress = metrics["completed_tasks"] / metrics["total_tasks"] * 100
+
+        status = {
+            "project_id": self.context["project_id"],
+            "project_name": self.context["project_name"],
+            "state": self.context["state"],
+            "epoch": self.epoch,
+            "version": self.version,
+            "overall_progress": round(overall_progress, 2),
+            "metrics": metrics,
+            "tasks_by_status": {
+                status: len(task_ids)
+                for status, task_ids in self._tasks_by_status.items()
+                if task_ids
+            },
+            "workers_by_status": dict(self._workers_by_status),
+            "active_workers": sum(
+                self._workers_by_status.get(s, 0) for s in ACTIVE_WORKER_STATUSES
+            )
+        }
+
+        if since is None:
+            return status
+
+        tasks = self.context["tasks"]
+        workers = self.context["workers"]
+        oldest = self._changes[0][0] if self._changes else self.version + 1
+
+        if since > self.version or since < oldest - 1 or (epoch is not None and epoch != self.epoch):
+            status.update({"reset": True, "tasks": dict(tasks), "workers": dict(workers)})
+            return status
+
+        changed_tasks, changed_workers = {}, {}
+        for version, (kind, entity_id) in reversed(self._changes):
+            if version <= since:
+                break
+            if kind == "task" and entity_id in tasks:
+                changed_tasks[entity_id] = tasks[entity_id]
+            elif kind == "worker" and entity_id in workers:
+                changed_workers[entity_id] = workers[entity_id]
+
+        status.update({"reset": False, "tasks": changed_tasks, "workers": changed_workers})
+        return status
+
+    async def add_conversation_entry(self, entry: dict):
+        """
+        Add an entry to conversation history.
+
+        The store lock is taken first (journal records need it, and a
+        transaction may log entries), then the history lock.
+
+        Args:
+            entry: Conversation entry (a timestamp is added)
+        """
+        entry = {
+            **entry,
+            "timestamp": datetime.utcnow().isoformat() + "Z"
+        }
+
+        async with self.lock, self.history_lock:
+            entry = self.history.append(entry)
+            self._record("conversation", entry=entry)
+
+    async def get_conversation(
+        self,
+        task_id: Optional[str] = None,
+        cursor: Optional[int] = None,
+        limit: int = 50
+    ) -> dict:
+        """
+        Page through conversation history, oldest first.
+
+        Entries still in memory are read under the lock; spilled segments
+        are read in an executor so paging old history doesn't stall dispatch.
+
+        Args:
+            task_id: Only entries about this task (None for all)
+            cursor: Seq of the last entry already seen (None to start from the beginning)
+            limit: Maximum entries to return
+
+        Returns:
+            Dictionary with entries and next_cursor (None once the end was reached)
+        """
+        cursor = cursor or 0
+
+        async with self.history_lock:
+            recent = [
+                entry for entry in self.history.recent
+                if entry["seq"] > cursor and (task_id is None or entry_task_id(entry) == task_id)
+            ]
+            segments = self.history.segments() if cursor < self.history.spilled_seq else []
+
+        entries = []
+        if segments:
+            loop = asyncio.get_running_loop()
+            entries = await loop.run_in_executor(
+                None, self.history.read_spilled, segments, task_id, cursor, limit
+            )
+
+        # Everything spilled precedes everything still in memory
+        entries.extend(recent[:limit - len(entries)])
+        return {
+            "entries": entries,
+            "next_cursor": entries[-1]["seq"] if len(entries) == limit else None
+        }
+
+    async def get_scaling_signals(self) -> dict:
+        """
+        Get the load signals used to size the worker pool.
+
+        Returns:
+            Dictionary with ready task count per capability, smoothed task
+            duration per capability, and busy/idle seconds and held task
+            count per worker
+        """
+        async with self.lock:
+            self._mark_silent_workers()
+            busy, idle = self._utilization_seconds()
             return {
-                "project_id": self.context["project_id"],
-                "project_name": self.context["project_name"],
-                "state": self.context["state"],
-                "overall_progress": round(overall_progress, 2),
-                "metrics": self.context["metrics"],
-                "tasks_by_status": tasks_by_status,
-                "workers_by_status": workers_by_status,
-                "active_workers": len([
-                    w for w in self.context["workers"].values()
-                    if w["status"] in [WorkerStatus.ACTIVE.value, WorkerStatus.BUSY.value]
-                ])
+                "ready_by_capability": {cap: count for (cap,), count in self._ready_depth().items()},
+                "task_duration_seconds": dict(self._task_seconds),
+                "workers": {
+                    worker_id: {
+                        "busy_seconds": busy[(worker_id,)],
+                        "idle_seconds": idle[(worker_id,)],
+                        "current_tasks": int(self._utilization[worker_id][0])
+                    }
+                    for (worker_id,) in busy
+                }
             }
 
-    async def add_conversation_entry(self, entry: dict):
-        """Add an entry to conversation history."""
+    async def get_schedule_report(self) -> dict:
+        """
+        Compare the predicted makespan with actual execution.
+
+        The prediction is the critical-path length when the first task was
+        claimed. The current estimate adds the remaining critical path to
+        the time elapsed so far.
+
+        Returns:
+            Dictionary with predicted, estimated and actual makespan in
+            seconds, the remaining critical path, and the duration calibration
+        """
         async with self.lock:
-            self.context["conversation_history"].append({
-                **entry,
-                "timestamp": datetime.utcnow().isoformat() + "Z"
-            })
-        await self._save()
+            self._settle_ranks()
+            tasks = self.context["tasks"]
+            finished = (TaskStatus.COMPLETED.value, TaskStatus.FAILED.value)
+
+            def unfinished(task_id: str) -> bool:
+                return tasks[task_id]["status"] not in finished
+
+            remaining = max((self._rank[t] for t in tasks if unfinished(t) and t in self._rank), default=0.0)
+
+            started = self._execution_started
+            end = self._execution_finished or time.time()
+            elapsed = end - started if started is not None else 0.0
+
+            path = critical_path(
+                [t for t in tasks if unfinished(t) and not any(
+                    d in tasks and unfinished(d) for d in tasks[t].get("dependencies", [])
+                )],
+                self._rank,
+                self._dependents,
+                unfinished
+            )
+
+            return {
+                "predicted_makespan_seconds": (
+                    round(self._predicted_makespan, 1) if self._predicted_makespan is not None else None
+                ),
+                "estimated_makespan_seconds": round(elapsed + remaining, 1),
+                "actual_makespan_seconds": (
+                    round(elapsed, 1) if self._execution_finished is not None else None
+                ),
+                "elapsed_seconds": round(elapsed, 1),
+                "remaining_critical_path": [
+                    {"task_id": t, "rank_seconds": round(self._rank[t], 1)} for t in path
+                ],
+                "seconds_per_estimated_hour": {
+                    "overall": self._durations.overall_seconds_per_hour,
+                    **self._durations.seconds_per_hour
+                }
+            }
+
+    async def lookup_cached_result(self, task: dict) -> Optional[dict]:
+        """
+        Look up the cached result of a claimed task (file read off the event loop).
+
+        Args:
+            task: Task as returned by claim_next_task
+
+        Returns:
+            Cache entry ({"result", "task_id", "seconds"}), or None on a miss
+        """
+        key = task.get("cache_key")
+        if self.result_cache is None or key is None:
+            return None
+
+        entry = await asyncio.get_running_loop().run_in_executor(None, self.result_cache.get, key)
+        if entry is None or "result" not in entry:
+            self._cache_lookups.inc(outcome="miss")
+            return None
+
+        self._cache_lookups.inc(outcome="hit")
+        self._cache_saved_seconds.inc(entry.get("seconds") or 0.0)
+        return entry
+
+    async def store_cached_result(self, task_id: str):
+        """
+        Cache the result of a task that just completed.
+
+        Results served from the cache, and tasks without a cache key,
+        are not stored. The task is already completed, so a failure to
+        write the entry is only reported as a warning.
+
+        Args:
+            task_id: Completed task
+        """
+        task = await self.get_task(task_id)
+        if (
+            self.result_cache is None
+            or task is None
+            or task["status"] != TaskStatus.COMPLETED.value
+            or task.get("cache_hit")
+            or not task.get("cache_key")
+        ):
+            return
+
+        entry = {
+            "result": task.get("result"),
+            "task_id": task_id,
+            "seconds": task.get("execution_seconds")
+        }
+        try:
+            await asyncio.get_running_loop().run_in_executor(None, self.result_cache.put, task["cache_key"], entry)
+        except (OSError, TypeError, ValueError) as e:
+            print(f"Warning: Failed to cache result of task {task_id}: {e}")
 
     async def get_task(self, task_id: str) -> Optional[dict]:
-        """Get a specific task by ID."""
-        async with self.lock:
-            return self.context["tasks"].get(task_id)
+        """Get a copy of a specific task by ID, as of the last committed change."""
+        if self.lock.held_by_current_task():
+            task = self.context["tasks"].get(task_id)
+            return _copy_entity(task) if task is not None else None
+        return self._view_tasks.get(task_id)
 
     async def get_worker(self, worker_id: str) -> Optional[dict]:
-        """Get a specific worker by ID."""
-        async with self.lock:
-            return self.context["workers"].get(worker_id)
+        """Get a copy of a specific worker by ID, as of the last committed change."""
+        if self.lock.held_by_current_task():
+            worker = self.context["workers"].get(worker_id)
+            return _copy_entity(worker) if worker is not None else None
+        return self._view_workers.get(worker_id)
 
     async def complete_project(self):
         """Mark project as completed."""
         async with self.lock:
             self.context["state"] = "completed"
             self.context["metrics"]["end_time"] = datetime.utcnow().isoformat() + "Z"
-        await self._save()
+            self._record("project", fields={
+                "state": self.context["state"],
+                "metrics": self.context["metrics"]
+            })
+            self._save()
@@ -0,0 +1,334 @@
+"""
+Conversation History for the Context Store.
+
+Keeps the most recent conversation entries in memory and spills older
+ones to segmented append-only files with an offset index, so memory use
+and snapshot size stay flat however long a project runs.
+"""
+
+import os
+import threading
+from collections import OrderedDict, deque
+from typing import Deque, Dict, List, Optional, Tuple
+
+from logging import codec
+
+
+# Segment indexes kept in memory for paging
+INDEX_CACHE_SIZE = 4
+
+# Index line: [seq, byte offset, byte length, task id or None]
+IndexEntry = Tuple[int, int, int, Optional[str]]
+
+
+def entry_task_id(entry: dict) -> Optional[str]:
+    """Task an entry is about, if any (top-level or inside a logged event's data)."""
+    task_id = entry.get("task_id")
+    if task_id is None and isinstance(entry.get("data"), dict):
+        task_id = entry["data"].get("task_id")
+    return task_id
+
+
+class ConversationHistory:
+    """
+    Ring buffer of recent entries plus spilled, indexed segments.
+
+    Layout on disk (<storage_path>.history/):
+    - segment-NNNNNN.ndjson: spilled entries, append-only
+    - segment-NNNNNN.idx: one [seq, offset, length, task_id] line per entry
+    - manifest.json: seq range and task ids of each closed segment
+
+    Every entry carries a "seq" that doubles as the paging cursor. The
+    ring itself is persisted by the context store (snapshot and journal).
+    An entry is indexed only after its data is written, and entries at or
+    below the last spilled seq are skipped on replay, so a crash neither
+    duplicates nor loses an entry.
+    """
+
+    def __init__(self, directory: str, memory_entries: int = 1000, segment_bytes: int = 4 * 1024 * 1024):
+        """
+        Initialize the history and recover its segments.
+
+        Args:
+            directory: Directory for segment files
+            memory_entries: Entries kept in memory
+            segment_bytes: Size at which a segment is closed and a new one started
+        """
+        self.directory = directory
+        self.memory_entries = max(1, memory_entries)
+        self.segment_bytes = segment_bytes
+
+        self.recent: Deque[dict] = deque()
+        self.last_seq = 0
+        self.spilled_seq = 0
+
+        # Closed segments: number -> {"first_seq", "last_seq", "count", "task_ids"}
+        self._segments: Dict[int, dict] = {}
+
+        # Segment currently being appended to
+        self._active: Optional[int] = None
+        self._active_summary: Optional[dict] = None
+        self._active_data = None
+        self._active_index = None
+        self._active_size = 0
+
+        # Paging reads run off the store lock, so the cache has its own
+        self._index_cache: "OrderedDict[int, List[IndexEntry]]" = OrderedDict()
+        self._cache_lock = threading.Lock()
+
+        os.makedirs(directory, exist_ok=True)
+        self._recover()
+
+    def _path(self, number: int, suffix: str) -> str:
+        """Path of a segment's data (ndjson) or index (idx) file."""
+        return os.path.join(self.directory, f"segment-{number:06d}.{suffix}")
+
+    @property
+    def _manifest_path(self) -> str:
+        return os.path.join(self.directory, "manifest.json")
+
+    def _recover(self):
+        """Load the manifest and reopen the last open segment, dropping a torn tail."""
+        if os.path.exists(self._manifest_path):
+            try:
+                with open(self._manifest_path, 'rb') as f:
+                    manifest = codec.loads(f.read())
+                self._segments = {int(k): v for k, v in manifest.get("segments", {}).items()}
+            except (codec.DecodeError, IOError) as e:
+                print(f"Warning: Could not load history manifest {self._manifest_path}: {e}")
+
+        numbers = sorted(
+            int(name[len("segment-"):-len(".idx")])
+            for name in os.listdir(self.directory)
+            if name.startswith("segment-") and name.endswith(".idx")
+        )
+
+        # Segments missing from the manifest were open (or sealed just before a crash)
+        unsealed = [n for n in numbers if n not in self._segments]
+        for number in unsealed[:-1]:
+            self._segments[number] = self._summarize(self._read_index(number)[0])
+
+        if self._segments:
+            self.spilled_seq = max(s["last_seq"] for s in self._segments.values())
+        if unsealed:
+            self._open_segment(unsealed[-1])
+        self.last_seq = self.spilled_seq
+
+    @staticmethod
+    def _summarize(index: List[IndexEntry]) -> dict:
+        """Seq range and task ids of a segment."""
+        return {
+            "first_seq": index[0][0] if index else 0,
+            "last_seq": index[-1][0] if index else 0,
+            "count": len(index),
+            "task_ids": sorted({task_id for _, _, _, task_id in index if task_id is not None})
+        }
+
+    def _read_index(self, number: int) -> Tuple[List[IndexEntry], int]:
+        """
+        Read a segment's index.
+
+        Returns:
+            Tuple of (index entries, bytes of the index file that are intact)
+        """
+        index = []
+        valid_bytes = 0
+        path = self._path(number, "idx")
+        if not os.path.exists(path):
+            return index, valid_bytes
+
+        with open(path, 'rb') as f:
+            for raw in f:
+                try:
+                    seq, offset, length, task_id = codec.loads(raw)
+                except (codec.DecodeError, ValueError, TypeError):
+                    break
+                index.append((seq, offset, length, task_id))
+                valid_bytes += len(raw)
+        return index, valid_bytes
+
+    def _open_segment(self, number: int):
+        """Open a segment for appending, truncating anything its index doesn't cover."""
+        index, index_bytes = self._read_index(number)
+        data_size = index[-1][1] + index[-1][2] if index else 0
+
+        data_path = self._path(number, "ndjson")
+        index_path = self._path(number, "idx")
+        self._active_data = open(data_path, 'ab')
+        self._active_data.truncate(data_size)
+        self._active_index = open(index_path, 'ab')
+        self._active_index.truncate(index_bytes)
+
+        self._active = number
+        self._active_size = data_size
+        self._active_summary = self._summarize(index)
+        self._active_summary["task_ids"] = set(self._active_summary["task_ids"])
+        with self._cache_lock:
+            self._index_cache[number] = index
+        if index:
+            self.spilled_seq = max(self.spilled_seq, index[-1][0])
+
+    def _seal_segment(self):
+        """Close the active segment and record it in the manifest."""
+        self._active_data.close()
+        self._active_index.close()
+
+        summary = dict(self._active_summary)
+        summary["task_ids"] = sorted(summary["task_ids"])
+        self._segments[self._active] = summary
+        self._active = None
+
+        tmp_path = f"{self._manifest_path}.tmp"
+        with open(tmp_path, 'wb') as f:
+            f.write(codec.dumps_bytes({"segments": self._segments}))
+        os.replace(tmp_path, self._manifest_path)
+
+    def _spill(self, entry: dict):
+        """Append an entry evicted from the ring to the active segment."""
+        seq = entry["seq"]
+        if seq <= self.spilled_seq:
+            return
+
+        if self._active is not None and self._active_size >= self.segment_bytes:
+            self._seal_segment()
+        if self._active is None:
+            self._open_segment(max(self._segments, default=0) + 1)
+
+        line = codec.dumps_bytes(entry) + b"\n"
+        task_id = entry_task_id(entry)
+        index_entry = (seq, self._active_size, len(line), task_id)
+
+        # Data first: an index line never points at bytes that weren't written
+        self._active_data.write(line)
+        self._active_data.flush()
+        self._active_index.write(codec.dumps_bytes(list(index_entry)) + b"\n")
+        self._active_index.flush()
+
+        self._active_size += len(line)
+        summary = self._active_summary
+        if not summary["count"]:
+            summary["first_seq"] = seq
+        summary["last_seq"] = seq
+        summary["count"] += 1
+        if task_id is not None:
+            summary["task_ids"].add(task_id)
+        with self._cache_lock:
+            cached = self._index_cache.get(self._active)
+            if cached is not None:
+                cached.append(index_entry)
+        self.spilled_seq = seq
+
+    def append(self, entry: dict) -> dict:
+        """
+        Add an entry, assigning its seq if it has none.
+
+        Entries at or below the last seq seen are ignored, which makes
+        journal replay idempotent.
+
+        Args:
+            entry: Conversation entry
+
+        Returns:
+            The entry with its seq
+        """
+        if entry.get("seq") is None:
+            entry = {**entry, "seq": self.last_seq + 1}
+        elif entry["seq"] <= self.last_seq:
+            return entry
+
+        self.last_seq = entry["seq"]
+        self.recent.append(entry)
+        while len(self.recent) > self.memory_entries:
+            self._spill(self.recent.popleft())
+        return entry
+
+    def restore(self, entries: List[dict]):
+        """
+        Load the persisted ring after recovery.
+
+        A legacy, unbounded history list is spilled down to the ring size.
+
+        Args:
+            entries: Entries in order
+        """
+        for entry in entries:
+            self.append(entry)
+
+    def segments(self) -> List[Tuple[int, dict]]:
+        """Summaries of the segments holding entries, in seq order (taken under the store lock)."""
+        summaries = sorted(self._segments.items())
+        if self._active is not None and self._active_summary["count"]:
+            summary = dict(self._active_summary)
+            summary["task_ids"] = set(summary["task_ids"])
+            summaries.append((self._active, summary))
+        return summaries
+
+    def _index(self, number: int) -> List[IndexEntry]:
+        """A segment's index, through a small LRU cache."""
+        with self._cache_lock:
+            index = self._index_cache.get(number)
+            if index is not None:
+                self._index_cache.move_to_end(number)
+                return index
+
+        index = self._read_index(number)[0]
+        with self._cache_lock:
+            self._index_cache[number] = index
+            for cached in list(self._index_cache):
+                if len(self._index_cache) <= INDEX_CACHE_SIZE:
+                    break
+                if cached != self._active:
+                    del self._index_cache[cached]
+        return index
+
+    def read_spilled(
+        self,
+        segments: List[Tuple[int, dict]],
+        task_id: Optional[str],
+        cursor: int,
+        limit: int
+    ) -> List[dict]:
+        """
+        Read spilled entries after a cursor.
+
+        Safe to call without the store lock: segments are append-only and
+        only entries within the summaries taken under the lock are read.
+
+        Args:
+            segments: Result of segments()
+            task_id: Only entries about this task (None for all)
+            cursor: Return entries with seq above this
+            limit: Maximum entries
+
+        Returns:
+            Entries in seq order
+        """
+        found: List[dict] = []
+        for number, summary in segments:
+            if summary["last_seq"] <= cursor:
+                continue
+            if task_id is not None and task_id not in summary["task_ids"]:
+                continue
+
+            wanted = [
+                (offset, length)
+                for seq, offset, length, entry_task in list(self._index(number))
+                if cursor < seq <= summary["last_seq"] and (task_id is None or entry_task == task_id)
+            ]
+            if not wanted:
+                continue
+
+            with open(self._path(number, "ndjson"), 'rb') as f:
+                for offset, length in wanted[:limit - len(found)]:
+                    f.seek(offset)
+                    found.append(codec.loads(f.read(length)))
+            if len(found) >= limit:
+                break
+
+        return found
+
+    def close(self):
+        """Close the active segment's files; it is reopened for appending on restart."""
+        if self._active is not None:
+            self._active_data.close()
+            self._active_index.close()
@@ -0,0 +1,134 @@
+"""
+Write-Ahead Journal for the Context Store.
+
+Persists store mutations as an append-only NDJSON journal and
+periodically compacts them into a snapshot, so the cost of a write
+is proportional to the change rather than to the whole project state.
+Writes run on the StorageBackend writer thread.
+"""
+
+import os
+from typing import Any, List, Optional, Tuple
+
+from logging import codec
+from .storage import StorageBackend
+
+
+class StoreJournal(StorageBackend):
+    """
+    Append-only mutation journal with compacted snapshots.
+
+    Layout on disk:
+    - <storage_path>: compacted snapshot of the full context
+    - <storage_path>.journal: NDJSON records appended since that snapshot
+
+    Every record carries a monotonically increasing "seq". The snapshot
+    stores the seq of the last record it includes, so records left in the
+    journal by a crash between snapshot and truncation are skipped on replay.
+    """
+
+    def __init__(
+        self,
+        storage_path: str,
+        snapshot_interval: int = 500,
+        fsync: bool = False,
+        background: bool = True
+    ):
+        """
+        Initialize the journal.
+
+        Args:
+            storage_path: Path to the snapshot file
+            snapshot_interval: Number of records between compactions
+            fsync: Call os.fsync after every journal write
+            background: Write on a writer thread (False writes inline, before append returns)
+        """
+        super().__init__(snapshot_interval, fsync, background)
+        self.snapshot_path = storage_path
+        self.journal_path = f"{storage_path}.journal"
+        self._file = None
+
+    @property
+    def name(self) -> str:
+        return os.path.basename(self.journal_path)
+
+    def load(self) -> Tuple[Optional[dict], List[dict]]:
+        """
+        Load the snapshot and the journal tail written after it.
+
+        Returns:
+            Tuple of (snapshot state or None, records to replay in order)
+        """
+        state = None
+        snapshot_seq = 0
+
+        if os.path.exists(self.snapshot_path):
+            try:
+                with open(self.snapshot_path, 'rb') as f:
+                    state = codec.loads(f.read())
+                snapshot_seq = state.pop("_journal_seq", 0)
+            except (codec.DecodeError, IOError) as e:
+                print(f"Warning: Could not load snapshot from {self.snapshot_path}: {e}")
+                state = None
+
+        records = []
+        if os.path.exists(self.journal_path):
+            valid_bytes = 0
+            with open(self.journal_path, 'rb') as f:
+                for line_number, raw in enumerate(f, start=1):
+                    line = raw.strip()
+                    if line:
+                        try:
+                            record = codec.loads(line)
+                        except codec.DecodeError:
+                            # A torn final write from a crash; everything before it is intact
+                            print(f"Warning: Ignoring corrupt journal record at "
+                                  f"{self.journal_path}:{line_number}")
+                            break
+                        if record.get("seq", 0) > snapshot_seq:
+                            records.append(record)
+                    valid_bytes += len(raw)
+
+            # Drop the torn tail so new records start on a clean line
+            if valid_bytes < os.path.getsize(self.journal_path):
+                with open(self.journal_path, 'r+b') as f:
+                    f.truncate(valid_bytes)
+
+        self.seq = max([snapshot_seq] + [r["seq"] for r in records])
+        self.records_since_snapshot = len(records)
+
+        return state, records
+
+    def _open(self):
+        """Open the journal file for appending."""
+        if self._file is None:
+            self._file = open(self.journal_path, 'ab')
+        return self._file
+
+    def _encode(self, records: List[dict]) -> bytes:
+        return b"".join(codec.dumps_bytes(record) + b"\n" for record in records)
+
+    def _write(self, payloads: List[Any]):
+        f = self._open()
+        f.write(b"".join(payloads))
+        f.flush()
+        if self.fsync:
+            os.fsync(f.fileno())
+
+    def _write_snapshot(self, state: dict, seq: int):
+        tmp_path = f"{self.snapshot_path}.tmp"
+        with open(tmp_path, 'wb') as f:
+            f.write(codec.dumps_bytes({**state, "_journal_seq": seq}))
+            f.flush()
+            os.fsync(f.fileno())
+        os.replace(tmp_path, self.snapshot_path)
+
+        # Records up to seq are now in the snapshot
+        if self._file is not None:
+            self._file.close()
+        self._file = open(self.journal_path, 'wb')
+
+    def _close_files(self):
+        if self._file is not None:
+            self._file.close()
+            self._file = None
@@ -0,0 +1,135 @@
+"""
+Task Matching for the Context Store.
+
+Scores how well a worker fits a task so each task goes to the
+cheapest, fastest worker that can actually do it.
+"""
+
+from typing import Dict, List, Optional
+
+
+# Relative cost per task and latency of the models workers run on
+MODEL_PROFILES = {
+    "claude-3-5-haiku-20241022": {"cost": 1.0, "latency": 1.0},
+    "claude-3-5-sonnet-20241022": {"cost": 3.0, "latency": 2.0},
+    "claude-3-5-opus-20241022": {"cost": 15.0, "latency": 4.0},
+}
+
+# Used for workers whose model is unknown
+DEFAULT_MODEL_PROFILE = {"cost": 3.0, "latency": 2.0}
+
+
+class TaskMatcher:
+    """
+    Weighted worker/task fit score.
+
+    Components (each in 0..1):
+    - coverage: share of the task's required capabilities the worker has
+    - cost and latency: the worker's model, relative to the most expensive / slowest
+    - success: smoothed historical success rate of the worker's type
+    - locality: share of the task's dependencies this worker completed
+
+    score = coverage_weight * coverage + success_weight * success
+            + locality_weight * locality
+            - cost_weight * cost - latency_weight * latency
+    """
+
+    def __init__(
+        self,
+        coverage_weight: float = 4.0,
+        cost_weight: float = 1.5,
+        latency_weight: float = 0.5,
+        success_weight: float = 1.0,
+        locality_weight: float = 1.0,
+        model_profiles: Optional[Dict[str, Dict[str, float]]] = None
+    ):
+        """
+        Initialize the matcher.
+
+        Args:
+            coverage_weight: Weight of capability coverage
+            cost_weight: Weight of model cost (subtracted)
+            latency_weight: Weight of model latency (subtracted)
+            success_weight: Weight of the worker type's success rate
+            locality_weight: Weight of having completed the task's dependencies
+            model_profiles: Relative cost/latency per model (defaults to MODEL_PROFILES)
+        """
+        self.coverage_weight = coverage_weight
+        self.cost_weight = cost_weight
+        self.latency_weight = latency_weight
+        self.success_weight = success_weight
+        self.locality_weight = locality_weight
+        self.model_profiles = model_profiles or MODEL_PROFILES
+
+        self._max_cost = max(p["cost"] for p in self.model_profiles.values())
+        self._max_latency = max(p["latency"] for p in self.model_profiles.values())
+
+        # Completed / failed task counts per worker type
+        self._outcomes: Dict[str, List[int]] = {}
+
+    def record_outcome(self, worker_type: Optional[str], succeeded: bool):
+        """
+        Count a finished task toward its worker type's success rate.
+
+        Args:
+            worker_type: Type of the worker that ran the task
+            succeeded: Whether the task completed
+        """
+        if not worker_type:
+            return
+        counts = self._outcomes.setdefault(worker_type, [0, 0])
+        counts[0 if succeeded else 1] += 1
+
+    def success_rate(self, worker_type: Optional[str]) -> float:
+        """Laplace-smoothed success rate of a worker type (0.5 with no history)."""
+        completed, failed = self._outcomes.get(worker_type or "", [0, 0])
+        return (completed + 1) / (completed + failed + 2)
+
+    @staticmethod
+    def coverage(task: dict, capabilities: List[str]) -> float:
+        """Share of a task's required capabilities covered by a worker."""
+        required = task.get("required_capabilities") or []
+        if not required:
+            return 1.0
+        return len(set(required) & set(capabilities)) / len(required)
+
+    @staticmethod
+    def locality(task: dict, worker_id: str, tasks: Dict[str, dict]) -> float:
+        """Share of a task's dependencies completed by a worker."""
+        dependencies = [d for d in task.get("dependencies", []) if d in tasks]
+        if not dependencies:
+            return 0.0
+        mine = sum(1 for d in dependencies if tasks[d].get("assigned_to") == worker_id)
+        return mine / len(dependencies)
+
+    def score(
+        self,
+        task: dict,
+        worker_id: str,
+        capabilities: List[str],
+        worker: Optional[dict],
+        tasks: Dict[str, dict]
+    ) -> float:
+        """
+        Score how well a worker fits a task (higher is better).
+
+        Args:
+            task: Task record
+            worker_id: Candidate worker
+            capabilities: The worker's capabilities
+            worker: The worker's registered record, if any (for type and model)
+            tasks: All task records (for locality)
+
+        Returns:
+            Fit score
+        """
+        worker = worker or {}
+        model = self.model_profiles.get(worker.get("model"), DEFAULT_MODEL_PROFILE)
+
+        return (
+            self.coverage_weight * self.coverage(task, capabilities)
+            + self.success_weight * self.success_rate(worker.get("worker_type"))
+            + self.locality_weight * self.locality(task, worker_id, tasks)
+            - self.cost_weight * model["cost"] / self._max_cost
+            - self.latency_weight * model["latency"] / self._max_latency
+        )
@@ -0,0 +1,130 @@
+"""
+Task Result Cache.
+
+Completed task results keyed by what determines them: the task's inputs,
+the results of its dependencies and the model of the worker that runs
+it. Rerunning the same requirements (after a crash, or as a regression
+run) reuses them instead of executing the tasks again.
+"""
+
+import hashlib
+import json
+import os
+import re
+import tempfile
+from typing import Any, List, Optional
+
+from logging import codec
+
+
+# Task fields that determine its result (ids and scheduling fields don't)
+CACHE_KEY_FIELDS = ("description", "required_capabilities", "inputs")
+
+# Bump to invalidate every cached result
+CACHE_KEY_VERSION = 1
+
+_KEY = re.compile(r"^[0-9a-f]{64}$")
+
+
+def _canonical(value: Any) -> bytes:
+    """Encoding that is identical for equal values (sorted keys, no whitespace)."""
+    return json.dumps(value, sort_keys=True, separators=(',', ':'), default=str).encode("utf-8")
+
+
+def result_hash(result: Any) -> str:
+    """SHA-256 of a task result."""
+    return hashlib.sha256(_canonical(result)).hexdigest()
+
+
+def task_cache_key(task: dict, dependency_results: List[Any], model: Optional[str]) -> str:
+    """
+    Cache key of a task.
+
+    Args:
+        task: Task record
+        dependency_results: Results of the task's dependencies, in dependency order
+        model: Model of the worker that will run the task
+
+    Returns:
+        SHA-256 hex digest
+    """
+    inputs = {field: task.get(field) for field in CACHE_KEY_FIELDS}
+    inputs["required_capabilities"] = sorted(inputs["required_capabilities"] or [])
+    return hashlib.sha256(_canonical({
+        "version": CACHE_KEY_VERSION,
+        "inputs": inputs,
+        "dependencies": [result_hash(result) for result in dependency_results],
+        "model": model
+    })).hexdigest()
+
+
+class ResultCache:
+    """
+    Cached results stored one file per key under <storage_path>.cache/<first 2 hex>/<key>.
+
+    Entries are {"result", "task_id", "seconds"}: the result, the task that
+    produced it and how long it took to execute. Writes are atomic (temp
+    file + rename), so a crash never leaves a partial entry behind.
+    """
+
+    def __init__(self, directory: str):
+        """
+        Initialize the cache.
+
+        Args:
+            directory: Root directory for entries
+        """
+        self.directory = directory
+        os.makedirs(directory, exist_ok=True)
+
+    def _path(self, key: str) -> str:
+        """
+        Path of an entry.
+
+        Raises:
+            ValueError: If key is not a SHA-256 hex string
+        """
+        if not isinstance(key, str) or not _KEY.match(key):
+            raise ValueError(f"Invalid cache key: {key!r}")
+        return os.path.join(self.directory, key[:2], f"{key}.json")
+
+    def get(self, key: str) -> Optional[dict]:
+        """
+        Look up an entry.
+
+        Args:
+            key: Result of task_cache_key()
+
+        Returns:
+            Entry, or None if nothing is cached (or the entry is unreadable)
+        """
+        path = self._path(key)
+        try:
+            with open(path, 'rb') as f:
+                return codec.loads(f.read())
+        except FileNotFoundError:
+            return None
+        except (codec.DecodeError, IOError) as e:
+            print(f"Warning: Ignoring unreadable cache entry {path}: {e}")
+            return None
+
+    def put(self, key: str, entry: dict):
+        """
+        Store an entry, replacing any previous one.
+
+        Args:
+            key: Result of task_cache_key()
+            entry: {"result", "task_id", "seconds"}
+        """
+        path = self._path(key)
+        directory = os.path.dirname(path)
+        os.makedirs(directory, exist_ok=True)
+        # Unique per call, so concurrent puts of one key never share a temp file
+        fd, tmp_path = tempfile.mkstemp(dir=directory, prefix=f"{key}.", suffix=".tmp")
+        try:
+            with os.fdopen(fd, 'wb') as f:
+                f.write(codec.dumps_bytes(entry))
+            os.replace(tmp_path, path)
+        finally:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
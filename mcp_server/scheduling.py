@@ -0,0 +1,173 @@
+"""
+Critical-Path Scheduling for the Context Store.
+
+Computes upward ranks over the task dependency graph so the ready
+queue can dispatch tasks on the longest remaining chain first.
+"""
+
+from typing import Callable, Dict, List, Optional
+
+
+# Assumed seconds per estimated hour until some task has completed
+DEFAULT_SECONDS_PER_HOUR = 3600.0
+
+# Task duration used when a task has no estimate
+DEFAULT_TASK_HOURS = 1.0
+
+
+class DurationModel:
+    """
+    Converts estimated_hours into expected seconds, calibrated by actual durations.
+
+    Keeps an exponentially smoothed ratio of actual seconds to estimated
+    hours per capability and overall. A task's cost uses the mean ratio of
+    its required capabilities, falling back to the overall ratio.
+    """
+
+    def __init__(self, smoothing: float = 0.3):
+        """
+        Initialize the model.
+
+        Args:
+            smoothing: Weight of each new observation in the smoothed ratios
+        """
+        self.smoothing = smoothing
+        self.seconds_per_hour: Dict[str, float] = {}
+        self.overall_seconds_per_hour: Optional[float] = None
+
+    def _smooth(self, previous: Optional[float], value: float) -> float:
+        """Blend an observation into a smoothed value."""
+        if previous is None:
+            return value
+        return (1 - self.smoothing) * previous + self.smoothing * value
+
+    def observe(self, capabilities: List[str], estimated_hours: float, seconds: float) -> float:
+        """
+        Record the actual duration of a completed task.
+
+        Args:
+            capabilities: Task's required capabilities
+            estimated_hours: Task's estimate
+            seconds: Actual claim-to-completion time
+
+        Returns:
+            Relative change of the overall ratio (0 if unchanged)
+        """
+        ratio = seconds / (estimated_hours or DEFAULT_TASK_HOURS)
+        for cap in capabilities:
+            self.seconds_per_hour[cap] = self._smooth(self.seconds_per_hour.get(cap), ratio)
+
+        previous = self.overall_seconds_per_hour
+        self.overall_seconds_per_hour = self._smooth(previous, ratio)
+        if previous is None:
+            return 1.0
+        return abs(self.overall_seconds_per_hour - previous) / previous
+
+    def cost(self, task: dict) -> float:
+        """
+        Expected duration of a task in seconds.
+
+        Args:
+            task: Task record
+
+        Returns:
+            Expected seconds
+        """
+        fallback = self.overall_seconds_per_hour or DEFAULT_SECONDS_PER_HOUR
+        ratios = [
+            self.seconds_per_hour.get(cap, fallback)
+            for cap in task.get("required_capabilities") or []
+        ]
+        ratio = sum(ratios) / len(ratios) if ratios else fallback
+        return (task.get("estimated_hours") or DEFAULT_TASK_HOURS) * ratio
+
+
+def upward_ranks(
+    tasks: Dict[str, dict],
+    dependents: Dict[str, List[str]],
+    cost: Callable[[dict], float],
+    fixed: Optional[Dict[str, float]] = None
+) -> Dict[str, float]:
+    """
+    Compute the upward rank of every task.
+
+    rank(t) = cost(t) + max(rank(s) for s in dependents of t), i.e. the
+    length of the longest chain from t to the end of the plan. Edges
+    that would close a cycle are ignored.
+
+    Args:
+        tasks: Task records by id (the tasks to rank)
+        dependents: Task id -> ids of tasks that depend on it
+        cost: Expected duration of a task
+        fixed: Known ranks of tasks outside tasks; dependents found here
+            count with that rank, others outside tasks are ignored
+
+    Returns:
+        Rank by task id, for the tasks in tasks
+    """
+    fixed = fixed or {}
+    ranks: Dict[str, float] = {}
+    visiting = set()
+
+    for root in tasks:
+        if root in ranks:
+            continue
+
+        # Iterative post-order DFS over the dependents graph
+        stack = [(root, False)]
+        while stack:
+            task_id, expanded = stack.pop()
+            if task_id in ranks:
+                continue
+
+            children = [c for c in dependents.get(task_id, []) if c in tasks]
+            if expanded:
+                visiting.discard(task_id)
+                ranks[task_id] = cost(tasks[task_id]) + max(
+                    [ranks.get(c, 0.0) for c in children]
+                    + [fixed[c] for c in dependents.get(task_id, []) if c not in tasks and c in fixed],
+                    default=0.0
+                )
+                continue
+
+            visiting.add(task_id)
+            stack.append((task_id, True))
+            for child in children:
+                if child not in ranks and child not in visiting:
+                    stack.append((child, False))
+
+    return ranks
+
+
+def critical_path(
+    start_ids: List[str],
+    ranks: Dict[str, float],
+    dependents: Dict[str, List[str]],
+    include: Callable[[str], bool]
+) -> List[str]:
+    """
+    Follow the highest-rank chain from the best starting task.
+
+    Args:
+        start_ids: Candidate first tasks
+        ranks: Upward ranks by task id
+        dependents: Task id -> ids of tasks that depend on it
+        include: Whether a task may appear on the path
+
+    Returns:
+        Task ids along the critical path, in execution order
+    """
+    candidates = [t for t in start_ids if include(t) and t in ranks]
+    path: List[str] = []
+    seen = set()
+
+    while candidates:
+        task_id = max(candidates, key=lambda t: ranks[t])
+        path.append(task_id)
+        seen.add(task_id)
+        candidates = [
+            c for c in dependents.get(task_id, [])
+            if include(c) and c in ranks and c not in seen
+        ]
+
+    return path
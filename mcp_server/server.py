@@ -6,15 +6,32 @@ In production, this would use the official MCP SDK with proper protocol support.
 """
 
 import asyncio
-import json
-from typing import Dict, Any, Optional
+import contextlib
+import time
+from typing import Dict, Any, List, Optional
 from aiohttp import web
 import argparse
 from pathlib import Path
 
 from .context_store import ContextStore
+from .metrics import MetricsRegistry
 from .tools import register_tools
+from logging import codec
 from logging.json_logger import JSONLogger
+from logging.network_policy import NetworkLogPolicy
+from logging.tracing import TRACE_HEADER, Tracer, current_span, parse_traceparent
+
+
+# Request header carrying the client's remaining time budget in seconds
+DEADLINE_HEADER = "X-MCP-Timeout"
+
+# Time kept back from a long-poll so the response reaches the client before its deadline
+DEADLINE_MARGIN_SECONDS = 0.25
+
+
+def json_response(data: Any, status: int = 200) -> web.Response:
+    """Encode a JSON response with the shared codec."""
+    return web.Response(body=codec.dumps_bytes(data), status=status, content_type="application/json")
 
 
 class MCPServer:
@@ -25,6 +42,7 @@ class MCPServer:
     - Tool registration and execution
     - Context management
     - Request/response logging
+    - Prometheus metrics (GET /metrics)
     - CORS support (optional)
     """
 
@@ -34,7 +52,11 @@ class MCPServer:
         port: int = 8080,
         context_store_path: str = "context/project_store.json",
         log_file: str = "logs/project_activity.log",
-        enable_cors: bool = False
+        enable_cors: bool = False,
+        snapshot_interval: int = 500,
+        network_log_policy: Optional[NetworkLogPolicy] = None,
+        storage_backend: str = "journal",
+        result_cache: bool = True
     ):
         """
         Initialize MCP server.
@@ -45,20 +67,50 @@ class MCPServer:
             context_store_path: Path to context storage
             log_file: Path to log file
             enable_cors: Enable CORS support
+            snapshot_interval: Journal records between context store snapshots
+            network_log_policy: Sampling/truncation policy for network I/O logging
+            storage_backend: Context store backend (journal or sqlite)
+            result_cache: Reuse results of identical earlier tasks instead of executing them
         """
         self.host = host
         self.port = port
         self.enable_cors = enable_cors
 
+        # Metrics shared by the server and its context store
+        self.metrics = MetricsRegistry()
+        self._tool_latency = self.metrics.histogram(
+            "mcp_tool_call_duration_seconds",
+            "Tool call latency, including batched calls",
+            ("tool",)
+        )
+        self._tool_calls = self.metrics.counter(
+            "mcp_tool_calls_total",
+            "Tool calls handled, including batched calls",
+            ("tool", "transport")
+        )
+        self._tool_errors = self.metrics.counter(
+            "mcp_tool_call_errors_total",
+            "Tool calls that failed",
+            ("tool", "status")
+        )
+
+        # Initialize logger; spans of traced calls and task lifecycles go to the same log
+        self.logger = JSONLogger("mcp_server", "server-001", log_file, network_policy=network_log_policy)
+        self.tracer = Tracer(self.logger)
+
         # Initialize context store
-        self.context_store = ContextStore(context_store_path)
+        self.context_store = ContextStore(
+            context_store_path,
+            snapshot_interval=snapshot_interval,
+            metrics=self.metrics,
+            storage_backend=storage_backend,
+            result_cache=result_cache,
+            tracer=self.tracer
+        )
 
         # Register tools
         self.tools = register_tools(self.context_store)
 
-        # Initialize logger
-        self.logger = JSONLogger("mcp_server", "server-001", log_file)
-
         # Create web application
         self.app = web.Application()
         self._setup_routes()
@@ -66,10 +118,57 @@ class MCPServer:
     def _setup_routes(self):
         """Setup HTTP routes."""
         self.app.router.add_post("/v1/mcp/tools/{tool_name}", self.handle_tool_call)
+        self.app.router.add_post("/v1/mcp/batch", self.handle_batch)
         self.app.router.add_get("/v1/mcp/status", self.handle_status)
         self.app.router.add_get("/v1/mcp/tools", self.handle_list_tools)
+        self.app.router.add_get("/metrics", self.handle_metrics)
         self.app.router.add_get("/health", self.handle_health)
 
+    def _observe_call(self, tool_name: str, transport: str, seconds: float, status: Optional[int] = None):
+        """
+        Record one tool call in the metrics.
+
+        Args:
+            tool_name: Tool name (unknown names are grouped)
+            transport: How the call arrived (http, batch or in_process)
+            seconds: Call latency
+            status: HTTP status for failed calls, None on success
+        """
+        tool = tool_name if tool_name in self.tools else "unknown"
+        self._tool_calls.inc(tool=tool, transport=transport)
+        self._tool_latency.observe(seconds, tool=tool)
+        if status is not None:
+            self._tool_errors.inc(tool=tool, status=str(status))
+
+    @contextlib.contextmanager
+    def _trace_call(self, tool_name: str, transport: str, parent=None):
+        """
+        Run a tool call as a tool.<name> span if the caller is traced.
+
+        Calls that arrive without trace context (idle polling, untraced
+        clients) record no span.
+
+        Args:
+            tool_name: Tool name (or "batch")
+            transport: How the call arrived
+            parent: Caller's (trace id, span id); the current span if omitted
+
+        Yields:
+            The span's attributes (empty and unrecorded for untraced calls)
+        """
+        parent = parent or current_span()
+        if parent is None:
+            yield {}
+            return
+        with self.tracer.span(f"tool.{tool_name}", parent=parent, transport=transport) as span:
+            yield span
+
+    async def _flush(self, span: dict):
+        """Wait for the call's mutations to reach disk, timing it as the span's flush_ms."""
+        started = time.perf_counter()
+        await self.context_store.flush()
+        span["flush_ms"] = round((time.perf_counter() - started) * 1000, 3)
+
     async def handle_tool_call(self, request: web.Request) -> web.Response:
         """
         Handle MCP tool call.
@@ -78,55 +177,263 @@ class MCPServer:
         Body: {"params": {...}}
         """
         tool_name = request.match_info["tool_name"]
+        endpoint = f"/v1/mcp/tools/{tool_name}"
         start_time = asyncio.get_event_loop().time()
 
+        # Decide once per call so request and response lines stay paired
+        sampled = self.logger.network_policy.should_log(endpoint)
+
         try:
             # Parse request body
-            body = await request.json()
+            body = codec.loads(await request.read())
             params = body.get("params", {})
 
             # Log incoming request
-            await self.logger.log_network_io(
-                direction="request",
-                protocol="http",
-                endpoint=f"/v1/mcp/tools/{tool_name}",
-                body={"params": params},
-                headers=dict(request.headers)
-            )
+            if sampled:
+                await self.logger.log_network_io(
+                    direction="request",
+                    protocol="http",
+                    endpoint=endpoint,
+                    body={"params": params},
+                    headers=dict(request.headers)
+                )
 
             # Check if tool exists
             if tool_name not in self.tools:
-                return web.json_response(
-                    {"error": f"Tool '{tool_name}' not found"},
-                    status=404
+                return await self._error_response(
+                    endpoint, f"Tool '{tool_name}' not found", 404, start_time, tool_name
                 )
 
-            # Execute tool
+            # Honor the caller's deadline: skip expired calls, shorten long-polls
+            budget = self._remaining_budget(request, start_time)
+            if budget is not None and budget <= 0:
+                return await self._error_response(
+                    endpoint, "Deadline exceeded", 504, start_time, tool_name
+                )
+            params = self._fit_to_budget(params, budget)
+
+            # Execute tool, continuing the caller's trace
             tool = self.tools[tool_name]
-            result = await tool["handler"](params)
+            with self._trace_call(tool_name, "http", parse_traceparent(request.headers.get(TRACE_HEADER))) as span:
+                result = await tool["handler"](params)
+
+                # Reply only once the call's mutations are on disk
+                await self._flush(span)
 
             # Calculate latency
             latency_ms = (asyncio.get_event_loop().time() - start_time) * 1000
+            self._observe_call(tool_name, "http", latency_ms / 1000)
 
             # Log response
+            if sampled:
+                await self.logger.log_network_io(
+                    direction="response",
+                    protocol="http",
+                    endpoint=endpoint,
+                    body=result,
+                    status_code=200,
+                    latency_ms=latency_ms
+                )
+
+            return json_response(result, status=200)
+
+        except codec.DecodeError:
+            return await self._error_response(
+                endpoint, "Invalid JSON in request body", 400, start_time, tool_name
+            )
+        except Exception as e:
+            # Log error
+            await self.logger.log(
+                "system_error",
+                {
+                    "tool": tool_name,
+                    "error": str(e),
+                    "type": type(e).__name__
+                },
+                level="ERROR"
+            )
+
+            return await self._error_response(endpoint, str(e), 500, start_time, tool_name)
+
+    @staticmethod
+    def _fit_to_budget(params: dict, budget: Optional[float]) -> dict:
+        """Shorten a long-poll's wait_seconds so it answers within the caller's budget."""
+        if budget is None or "wait_seconds" not in params:
+            return params
+        return {
+            **params,
+            "wait_seconds": max(0.0, min(
+                float(params["wait_seconds"]), budget - DEADLINE_MARGIN_SECONDS
+            ))
+        }
+
+    @staticmethod
+    def _remaining_budget(request: web.Request, start_time: float) -> Optional[float]:
+        """
+        Seconds left of the caller's deadline.
+
+        Args:
+            request: Incoming request
+            start_time: Loop time the request arrived
+
+        Returns:
+            Remaining seconds, or None if the caller sent no deadline
+        """
+        header = request.headers.get(DEADLINE_HEADER)
+        if header is None:
+            return None
+        try:
+            budget = float(header)
+        except ValueError:
+            return None
+        return budget - (asyncio.get_event_loop().time() - start_time)
+
+    async def _error_response(
+        self,
+        endpoint: str,
+        message: str,
+        status: int,
+        start_time: float,
+        tool_name: Optional[str] = None
+    ) -> web.Response:
+        """
+        Build an error response and log it regardless of sampling.
+
+        Args:
+            endpoint: Endpoint path
+            message: Error message
+            status: HTTP status code
+            start_time: Loop time when the request arrived
+            tool_name: Tool the failed call targeted, if any (recorded in metrics)
+
+        Returns:
+            JSON error response
+        """
+        body = {"error": message}
+        latency_ms = (asyncio.get_event_loop().time() - start_time) * 1000
+
+        if tool_name is not None:
+            self._observe_call(tool_name, "http", latency_ms / 1000, status)
+
+        await self.logger.log_network_io(
+            direction="response",
+            protocol="http",
+            endpoint=endpoint,
+            body=body,
+            status_code=status,
+            latency_ms=latency_ms
+        )
+
+        return json_response(body, status=status)
+
+    async def handle_batch(self, request: web.Request) -> web.Response:
+        """
+        Handle an ordered batch of MCP tool calls.
+
+        All calls run inside one context store transaction, so no other
+        call interleaves with them and they are persisted with a single
+        journal flush. Results are per call and nothing is rolled back:
+        a failing (or malformed) call is reported in its result slot,
+        earlier calls keep their effects, and later calls still run
+        unless stop_on_error is set. Long-polls don't wait in a batch
+        (wait_seconds is treated as 0), since the transaction holds the
+        store lock, and calls left when the caller's deadline passes are
+        answered with a deadline error.
+
+        POST /v1/mcp/batch
+        Body: {"calls": [{"tool": "...", "params": {...}}, ...], "stop_on_error": false}
+        """
+        endpoint = "/v1/mcp/batch"
+        start_time = asyncio.get_event_loop().time()
+        sampled = self.logger.network_policy.should_log(endpoint)
+
+        try:
+            body = codec.loads(await request.read())
+        except codec.DecodeError:
+            return await self._error_response(
+                endpoint, "Invalid JSON in request body", 400, start_time
+            )
+
+        if not isinstance(body, dict):
+            return await self._error_response(
+                endpoint, "Request body must be an object", 400, start_time
+            )
+
+        calls = body.get("calls", [])
+        stop_on_error = body.get("stop_on_error", False)
+
+        if not isinstance(calls, list):
+            return await self._error_response(
+                endpoint, "'calls' must be an array", 400, start_time
+            )
+
+        if sampled:
+            await self.logger.log_network_io(
+                direction="request",
+                protocol="http",
+                endpoint=endpoint,
+                body={
+                    "calls": len(calls),
+                    "tools": [call.get("tool") if isinstance(call, dict) else None for call in calls]
+                },
+                headers=dict(request.headers)
+            )
+
+        budget = self._remaining_budget(request, start_time)
+        if budget is not None and budget <= 0:
+            return await self._error_response(endpoint, "Deadline exceeded", 504, start_time)
+
+        results = await self.run_batch(
+            calls, stop_on_error, "batch", parse_traceparent(request.headers.get(TRACE_HEADER)), budget
+        )
+
+        latency_ms = (asyncio.get_event_loop().time() - start_time) * 1000
+
+        if sampled:
             await self.logger.log_network_io(
                 direction="response",
                 protocol="http",
-                endpoint=f"/v1/mcp/tools/{tool_name}",
-                body=result,
+                endpoint=endpoint,
+                body={"results": len(results), "errors": sum(1 for r in results if "error" in r)},
                 status_code=200,
                 latency_ms=latency_ms
             )
 
-            return web.json_response(result, status=200)
+        return json_response({"success": True, "results": results}, status=200)
 
-        except json.JSONDecodeError:
-            return web.json_response(
-                {"error": "Invalid JSON in request body"},
-                status=400
-            )
+    async def call_tool_local(
+        self,
+        tool_name: str,
+        params: dict,
+        budget: Optional[float] = None
+    ) -> dict:
+        """
+        Execute a tool for a caller in this process, without HTTP.
+
+        Args:
+            tool_name: Name of the tool
+            params: Tool parameters
+            budget: Seconds the caller will wait for the result, if bounded
+
+        Returns:
+            Tool result
+
+        Raises:
+            KeyError: If the tool does not exist
+            Exception: Whatever the tool handler raises
+        """
+        start_time = asyncio.get_event_loop().time()
+
+        if tool_name not in self.tools:
+            self._observe_call(tool_name, "in_process", 0.0, 404)
+            raise KeyError(f"Tool '{tool_name}' not found")
+
+        try:
+            with self._trace_call(tool_name, "in_process") as span:
+                result = await self.tools[tool_name]["handler"](self._fit_to_budget(params, budget))
+                await self._flush(span)
         except Exception as e:
-            # Log error
+            self._observe_call(tool_name, "in_process", asyncio.get_event_loop().time() - start_time, 500)
             await self.logger.log(
                 "system_error",
                 {
@@ -136,23 +443,119 @@ class MCPServer:
                 },
                 level="ERROR"
             )
+            raise
 
-            return web.json_response(
-                {"error": str(e)},
-                status=500
-            )
+        self._observe_call(tool_name, "in_process", asyncio.get_event_loop().time() - start_time)
+        return result
+
+    async def run_batch(
+        self,
+        calls: List[dict],
+        stop_on_error: bool,
+        transport: str,
+        parent=None,
+        budget: Optional[float] = None
+    ) -> List[dict]:
+        """
+        Execute an ordered batch of tool calls in one context store transaction.
+
+        Calls are not rolled back when a later one fails; each gets its
+        own result or error. Long-polls run with wait_seconds 0: waiting
+        inside the transaction would hold the store lock for everyone.
+
+        Args:
+            calls: [{"tool": "...", "params": {...}}, ...]
+            stop_on_error: Stop executing at the first failing call
+            transport: Metrics label for how the batch arrived
+            parent: Caller's (trace id, span id); the current span if omitted
+            budget: Seconds the caller will wait; calls still queued when it
+                runs out get a deadline error
+
+        Returns:
+            One entry per executed call: {"tool", "result"} or {"tool", "error"}
+            (a call that isn't {"tool": str, "params": dict} gets an error)
+        """
+        with self._trace_call("batch", transport, parent) as span:
+            span["calls"] = len(calls)
+            results = await self._run_batch_calls(calls, stop_on_error, transport, budget)
+            await self._flush(span)
+        return results
+
+    async def _run_batch_calls(
+        self,
+        calls: List[dict],
+        stop_on_error: bool,
+        transport: str,
+        budget: Optional[float] = None
+    ) -> List[dict]:
+        """Execute a batch's calls, each as a child span of the batch."""
+        results = []
+        batch_start = asyncio.get_event_loop().time()
+        async with self.context_store.transaction():
+            for call in calls:
+                call_start = asyncio.get_event_loop().time()
+                tool_name = call.get("tool") if isinstance(call, dict) else None
+                params = call.get("params", {}) if isinstance(call, dict) else None
+
+                if not isinstance(call, dict) or not isinstance(tool_name, str):
+                    results.append({"tool": tool_name, "error": "Each call must be an object with a 'tool' name"})
+                    self._observe_call(None, transport, 0.0, 400)
+                elif not isinstance(params, dict):
+                    results.append({"tool": tool_name, "error": "'params' must be an object"})
+                    self._observe_call(tool_name, transport, 0.0, 400)
+                elif tool_name not in self.tools:
+                    results.append({"tool": tool_name, "error": f"Tool '{tool_name}' not found"})
+                    self._observe_call(tool_name, transport, 0.0, 404)
+                elif budget is not None and budget - (call_start - batch_start) <= 0:
+                    results.append({"tool": tool_name, "error": "Deadline exceeded"})
+                    self._observe_call(tool_name, transport, 0.0, 504)
+                else:
+                    # Waiting here would hold the store lock (and delay every
+                    # waiter's wake-up) until the long-poll ends
+                    if "wait_seconds" in params:
+                        params = {**params, "wait_seconds": 0}
+                    try:
+                        with self._trace_call(tool_name, transport):
+                            result = await self.tools[tool_name]["handler"](params)
+                        results.append({"tool": tool_name, "result": result})
+                        self._observe_call(
+                            tool_name, transport, asyncio.get_event_loop().time() - call_start
+                        )
+                    except Exception as e:
+                        self._observe_call(
+                            tool_name, transport, asyncio.get_event_loop().time() - call_start, 500
+                        )
+                        await self.logger.log(
+                            "system_error",
+                            {
+                                "tool": tool_name,
+                                "error": str(e),
+                                "type": type(e).__name__
+                            },
+                            level="ERROR"
+                        )
+                        results.append({"tool": tool_name, "error": str(e)})
+
+                if stop_on_error and "error" in results[-1]:
+                    break
+
+        return results
 
     async def handle_status(self, request: web.Request) -> web.Response:
         """
         Get project status.
 
-        GET /v1/mcp/status
+        GET /v1/mcp/status[?since=<version>&epoch=<epoch>]
         """
         try:
-            status = await self.context_store.get_project_status()
-            return web.json_response(status)
+            since = request.query.get("since")
+            status = await self.context_store.get_project_status(
+                since=int(since) if since is not None else None,
+                epoch=request.query.get("epoch")
+            )
+            return json_response(status)
         except Exception as e:
-            return web.json_response(
+            return json_response(
                 {"error": str(e)},
                 status=500
             )
@@ -171,18 +574,30 @@ class MCPServer:
             for name, tool in self.tools.items()
         }
 
-        return web.json_response({
+        return json_response({
             "tools": tools_list,
             "count": len(tools_list)
         })
 
+    async def handle_metrics(self, request: web.Request) -> web.Response:
+        """
+        Export metrics in the Prometheus text format.
+
+        GET /metrics
+        """
+        return web.Response(
+            text=self.metrics.render(),
+            content_type="text/plain",
+            charset="utf-8"
+        )
+
     async def handle_health(self, request: web.Request) -> web.Response:
         """
         Health check endpoint.
 
         GET /health
         """
-        return web.json_response({
+        return json_response({
             "status": "healthy",
             "server": "mcp-autonomous-dev-team",
             "version": "1.0.0"
@@ -215,6 +630,7 @@ class MCPServer:
             "server_stopped",
             {"message": "Server shutting down"}
         )
+        self.context_store.close()
 
 
 async def main():
@@ -230,6 +646,19 @@ async def main():
                        choices=["DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"])
     parser.add_argument("--enable-cors", action="store_true",
                        help="Enable CORS support")
+    parser.add_argument("--snapshot-interval", type=int, default=500,
+                       help="Journal records between context store snapshots")
+    parser.add_argument("--storage-backend", default="journal", choices=["journal", "sqlite"],
+                       help="Context store backend")
+    parser.add_argument("--no-result-cache", action="store_true",
+                       help="Execute every task, even if an identical one has a cached result")
+    parser.add_argument("--network-log-mode", default="full",
+                       choices=sorted(NetworkLogPolicy.MODES),
+                       help="Network I/O logging mode")
+    parser.add_argument("--network-sample-rate", type=float, default=1.0,
+                       help="Fraction of tool calls whose network I/O is logged")
+    parser.add_argument("--network-max-body-bytes", type=int, default=4096,
+                       help="Truncate logged bodies larger than this (0 = never)")
 
     args = parser.parse_args()
 
@@ -239,7 +668,15 @@ async def main():
         port=args.port,
         context_store_path=args.context_store,
         log_file=args.log_file,
-        enable_cors=args.enable_cors
+        enable_cors=args.enable_cors,
+        snapshot_interval=args.snapshot_interval,
+        storage_backend=args.storage_backend,
+        result_cache=not args.no_result_cache,
+        network_log_policy=NetworkLogPolicy(
+            mode=args.network_log_mode,
+            default_sample_rate=args.network_sample_rate,
+            max_body_bytes=args.network_max_body_bytes
+        )
     )
 
     # Start server
@@ -0,0 +1,421 @@
+"""
+Storage Backends for the Context Store.
+
+A StorageBackend persists the context store's mutation records and
+snapshots. Two implementations exist:
+- journal: NDJSON journal plus compacted JSON snapshot (see journal.py)
+- sqlite: SQLite database in WAL mode, one row per task and worker
+
+Disk I/O runs on a writer thread: callers encode records (capturing
+their values) and return immediately, and flush() tells them when
+everything so far is on disk. Records queued while a write is in
+progress go out together in the next write (group commit).
+"""
+
+import fcntl
+import os
+import queue
+import sqlite3
+import threading
+from concurrent.futures import Future
+from typing import Any, Dict, List, Optional, Tuple
+
+from logging import codec
+
+
+class StorageBackend:
+    """
+    Base class for context store persistence.
+
+    Subclasses implement load(), _encode(), _write() and _write_snapshot().
+    Records and snapshots are written in the order they were submitted.
+    """
+
+    # Whether snapshot() needs every task and worker (False if they are stored as they change)
+    full_snapshots = True
+
+    def __init__(self, snapshot_interval: int = 500, fsync: bool = False, background: bool = True):
+        """
+        Initialize the backend.
+
+        Args:
+            snapshot_interval: Number of records between snapshots
+            fsync: Make every write durable against power loss, not just a process crash
+            background: Write on a writer thread (False writes inline, before append returns)
+        """
+        self.snapshot_interval = snapshot_interval
+        self.fsync = fsync
+        self.background = background
+
+        self.seq = 0
+        self.records_since_snapshot = 0
+
+        # Writer thread state: items are ("records", payload), ("snapshot", state, seq), futures or None
+        self._queue: "queue.Queue" = queue.Queue()
+        self._thread: Optional[threading.Thread] = None
+        self._submitted = 0
+        self._written = 0
+
+    @property
+    def name(self) -> str:
+        """Label for the writer thread."""
+        return type(self).__name__
+
+    def load(self) -> Tuple[Optional[dict], List[dict]]:
+        """
+        Load persisted state.
+
+        Returns:
+            Tuple of (state or None, records to replay in order)
+        """
+        raise NotImplementedError
+
+    def _encode(self, records: List[Dict[str, Any]]) -> Any:
+        """Encode records for _write. Called by the appending thread."""
+        raise NotImplementedError
+
+    def _write(self, payloads: List[Any]):
+        """Durably write encoded record payloads, in order, as one write."""
+        raise NotImplementedError
+
+    def _write_snapshot(self, state: dict, seq: int):
+        """Write a snapshot that includes every record up to seq."""
+        raise NotImplementedError
+
+    def _close_files(self):
+        """Close open files or connections."""
+        pass
+
+    def _submit(self, item: Any):
+        """Hand an item to the writer thread, starting it on first use."""
+        if self._thread is None:
+            self._thread = threading.Thread(target=self._run, name=f"storage-writer:{self.name}", daemon=True)
+            self._thread.start()
+        self._submitted += 1
+        self._queue.put(item)
+
+    def append(self, record: Dict[str, Any]) -> bool:
+        """
+        Append a mutation record.
+
+        Args:
+            record: Mutation record (must be JSON serializable)
+
+        Returns:
+            True if a snapshot is due
+        """
+        return self.append_batch([record])
+
+    def append_batch(self, records: List[Dict[str, Any]]) -> bool:
+        """
+        Append several mutation records as a single write.
+
+        Args:
+            records: Mutation records, in order
+
+        Returns:
+            True if a snapshot is due
+        """
+        for record in records:
+            self.seq += 1
+            record["seq"] = self.seq
+        payload = self._encode(records)
+
+        if self.background:
+            self._submit(("records", payload))
+        else:
+            self._write([payload])
+
+        self.records_since_snapshot += len(records)
+        return self.records_since_snapshot >= self.snapshot_interval
+
+    def snapshot(self, state: dict):
+        """
+        Write a snapshot of the full state.
+
+        In background mode the state is encoded on the writer thread, so it
+        must not be mutated afterwards (pass a copy of live state).
+
+        Args:
+            state: Context state to persist
+        """
+        if self.background:
+            self._submit(("snapshot", state, self.seq))
+        else:
+            self._write_snapshot(state, self.seq)
+        self.records_since_snapshot = 0
+
+    def flush(self) -> Future:
+        """
+        Future resolved once everything submitted so far is written.
+
+        Returns:
+            Future (already resolved if nothing is outstanding); its
+            exception is set if a write failed
+        """
+        future: Future = Future()
+        if self._written >= self._submitted:
+            future.set_result(None)
+            return future
+        self._queue.put(future)
+        return future
+
+    def _run(self):
+        """Writer thread main loop."""
+        while True:
+            items = [self._queue.get()]
+            # Group commit: take everything queued behind the first item
+            while True:
+                try:
+                    items.append(self._queue.get_nowait())
+                except queue.Empty:
+                    break
+
+            pending: List[Any] = []
+            waiters: List[Future] = []
+            error: Optional[Exception] = None
+            stop = False
+
+            for item in items:
+                if isinstance(item, Future):
+                    waiters.append(item)
+                    continue
+                if item is not None and item[0] == "records":
+                    pending.append(item[1])
+                    continue
+                try:
+                    if pending:
+                        self._write(pending)
+                        pending = []
+                    if item is None:
+                        stop = True
+                    else:
+                        self._write_snapshot(item[1], item[2])
+                # Any failure, encoding included, goes to the waiters: if the
+                # thread died instead, every later flush() would hang
+                except Exception as e:
+                    print(f"Warning: Could not write {self.name} storage: {e}")
+                    pending = []
+                    error = e
+
+            try:
+                if pending:
+                    self._write(pending)
+            except Exception as e:
+                print(f"Warning: Could not write {self.name} storage: {e}")
+                error = e
+
+            self._written += sum(1 for item in items if item is not None and not isinstance(item, Future))
+            for waiter in waiters:
+                if error is not None:
+                    waiter.set_exception(error)
+                else:
+                    waiter.set_result(None)
+
+            if stop:
+                return
+
+    def close(self):
+        """Write everything outstanding, stop the writer thread and close files."""
+        if self._thread is not None:
+            self._queue.put(None)
+            self._thread.join()
+            self._thread = None
+        self._close_files()
+
+
+class SQLiteBackend(StorageBackend):
+    """
+    SQLite storage in WAL mode.
+
+    Tasks and workers are stored one row each as they change, with their
+    status (and a task's worker) in plain columns, so a restart reads
+    rows instead of parsing one large JSON document, and other processes
+    can query the state while the server writes (WAL readers never block
+    the writer). Dispatch indexes live in memory and load() reads whole
+    tables, so no secondary indexes are kept: they would only add work
+    to every write. Project fields, plan and metrics
+    live in a key/value table; snapshots only rewrite those and trim the
+    conversation table to the in-memory ring.
+
+    Only one process may own the database: opening it takes an exclusive
+    lock on <database_path>.lock, so a second server on the same file
+    fails at once instead of overwriting the first one's snapshots.
+    Read-only queries from other processes don't take the lock.
+    """
+
+    full_snapshots = False
+
+    SCHEMA = """
+        CREATE TABLE IF NOT EXISTS tasks (
+            id TEXT PRIMARY KEY,
+            status TEXT NOT NULL,
+            assigned_to TEXT,
+            doc BLOB NOT NULL
+        );
+        CREATE TABLE IF NOT EXISTS workers (
+            id TEXT PRIMARY KEY,
+            status TEXT NOT NULL,
+            doc BLOB NOT NULL
+        );
+        CREATE TABLE IF NOT EXISTS meta (
+            key TEXT PRIMARY KEY,
+            value BLOB NOT NULL
+        );
+        CREATE TABLE IF NOT EXISTS conversation (
+            seq INTEGER PRIMARY KEY,
+            entry BLOB NOT NULL
+        );
+    """
+
+    # State keys stored as their own tables rather than in meta
+    TABLE_KEYS = ("tasks", "workers", "conversation_history")
+
+    def __init__(
+        self,
+        database_path: str,
+        snapshot_interval: int = 500,
+        fsync: bool = False,
+        background: bool = True,
+        busy_timeout_seconds: float = 5.0
+    ):
+        """
+        Open (or create) the database.
+
+        Args:
+            database_path: Path to the SQLite file
+            snapshot_interval: Number of records between snapshots
+            fsync: synchronous=FULL instead of NORMAL
+            background: Write on a writer thread
+            busy_timeout_seconds: How long to wait for another process's write lock
+
+        Raises:
+            RuntimeError: If another store already has the database open
+        """
+        super().__init__(snapshot_interval, fsync, background)
+        self.database_path = database_path
+
+        self._lock_file = open(f"{database_path}.lock", "a")
+        try:
+            fcntl.flock(self._lock_file, fcntl.LOCK_EX | fcntl.LOCK_NB)
+        except BlockingIOError:
+            self._lock_file.close()
+            raise RuntimeError(f"{database_path} is already open in another context store")
+
+        # Used by load() before the writer thread starts, then only by the writer
+        self._db = sqlite3.connect(database_path, timeout=busy_timeout_seconds, check_same_thread=False)
+        self._db.execute("PRAGMA journal_mode=WAL")
+        self._db.execute(f"PRAGMA synchronous={'FULL' if fsync else 'NORMAL'}")
+        self._db.executescript(self.SCHEMA)
+
+    @property
+    def name(self) -> str:
+        return os.path.basename(self.database_path)
+
+    def load(self) -> Tuple[Optional[dict], List[dict]]:
+        meta = {key: codec.loads(value) for key, value in self._db.execute("SELECT key, value FROM meta")}
+        if not meta:
+            return None, []
+
+        self.seq = meta.pop("_seq", 0)
+        state = dict(meta)
+        state["tasks"] = {
+            task_id: codec.loads(doc) for task_id, doc in self._db.execute("SELECT id, doc FROM tasks")
+        }
+        state["workers"] = {
+            worker_id: codec.loads(doc) for worker_id, doc in self._db.execute("SELECT id, doc FROM workers")
+        }
+        state["conversation_history"] = [
+            codec.loads(entry) for (entry,) in self._db.execute("SELECT entry FROM conversation ORDER BY seq")
+        ]
+        return state, []
+
+    def _encode(self, records: List[Dict[str, Any]]) -> List[Tuple[str, tuple]]:
+        statements = []
+        for record in records:
+            op = record["op"]
+            if op == "task":
+                task = record["task"]
+                statements.append(("task", (
+                    task["id"], task["status"], task.get("assigned_to"), codec.dumps_bytes(task)
+                )))
+            elif op == "worker":
+                worker = record["worker"]
+                statements.append(("worker", (worker["id"], worker["status"], codec.dumps_bytes(worker))))
+            elif op == "project":
+                for key, value in record["fields"].items():
+                    statements.append(("meta", (key, codec.dumps_bytes(value))))
+            elif op in ("plan", "metrics"):
+                statements.append(("meta", (op, codec.dumps_bytes(record[op]))))
+            elif op == "conversation":
+                statements.append(("conversation", (record["entry"]["seq"], codec.dumps_bytes(record["entry"]))))
+        statements.append(("meta", ("_seq", codec.dumps_bytes(records[-1]["seq"]))))
+        return statements
+
+    def _write(self, payloads: List[Any]):
+        with self._db:
+            for statements in payloads:
+                for kind, values in statements:
+                    if kind == "task":
+                        self._db.execute(
+                            "INSERT INTO tasks (id, status, assigned_to, doc) VALUES (?, ?, ?, ?) "
+                            "ON CONFLICT (id) DO UPDATE SET status = excluded.status, "
+                            "assigned_to = excluded.assigned_to, doc = excluded.doc",
+                            values
+                        )
+                    elif kind == "worker":
+                        self._db.execute("INSERT OR REPLACE INTO workers (id, status, doc) VALUES (?, ?, ?)", values)
+                    elif kind == "meta":
+                        self._db.execute("INSERT OR REPLACE INTO meta (key, value) VALUES (?, ?)", values)
+                    elif kind == "conversation":
+                        self._db.execute("INSERT OR REPLACE INTO conversation (seq, entry) VALUES (?, ?)", values)
+
+    def _write_snapshot(self, state: dict, seq: int):
+        ring = state.get("conversation_history", [])
+        with self._db:
+            self._db.executemany(
+                "INSERT OR REPLACE INTO meta (key, value) VALUES (?, ?)",
+                [(key, codec.dumps_bytes(value)) for key, value in state.items() if key not in self.TABLE_KEYS]
+                + [("_seq", codec.dumps_bytes(seq))]
+            )
+            # Entries older than the ring live in the history segments
+            self._db.execute("DELETE FROM conversation WHERE seq < ?", (ring[0]["seq"] if ring else seq + 1,))
+            self._db.executemany(
+                "INSERT OR REPLACE INTO conversation (seq, entry) VALUES (?, ?)",
+                [(entry["seq"], codec.dumps_bytes(entry)) for entry in ring]
+            )
+
+    def _close_files(self):
+        self._db.close()
+        self._lock_file.close()
+
+
+def create_storage_backend(
+    kind: str,
+    storage_path: str,
+    snapshot_interval: int = 500,
+    fsync: bool = False,
+    background: bool = True
+) -> StorageBackend:
+    """
+    Create a storage backend by name.
+
+    Args:
+        kind: journal or sqlite
+        storage_path: Snapshot path; the SQLite database sits next to it with a .db extension
+        snapshot_interval: Number of records between snapshots
+        fsync: Make every write durable against power loss
+        background: Write on a writer thread
+
+    Returns:
+        The backend
+
+    Raises:
+        ValueError: If the kind is unknown
+    """
+    if kind == "journal":
+        from .journal import StoreJournal
+        return StoreJournal(storage_path, snapshot_interval, fsync, background)
+    if kind == "sqlite":
+        return SQLiteBackend(f"{os.path.splitext(storage_path)[0]}.db", snapshot_interval, fsync, background)
+    raise ValueError(f"Unknown storage backend: {kind}")
@@ -0,0 +1,189 @@
+"""
+Live Task Output Streams.
+
+Workers stream incremental output (model tokens, step logs) for running
+tasks; the UI and lead tail it. Only the most recent output is kept per
+task, in memory: the full transcript is uploaded as a blob when the task
+finishes and referenced from its result.
+"""
+
+import asyncio
+from collections import OrderedDict
+from typing import Dict, Optional
+
+
+class TaskOutputStreams:
+    """
+    Bounded, offset-addressed output buffer per task.
+
+    Offsets count characters from the start of a task's output. Every
+    append carries the offset it starts at, so resent chunks are trimmed
+    instead of duplicated, and a lost chunk shows up as a gap (reported
+    to readers as truncated) rather than misplacing later output.
+
+    Each claim of a task starts a new epoch (the task's claims count):
+    the stream is emptied and reopened, and appends from a worker that
+    held an earlier claim are rejected, so a reclaimed or retried
+    task's new output starts again at offset 0.
+    """
+
+    def __init__(self, buffer_chars: int = 64 * 1024, max_finished: int = 256):
+        """
+        Initialize the streams.
+
+        Args:
+            buffer_chars: Characters of recent output kept per task
+            max_finished: Streams of finished tasks kept for late readers
+        """
+        self.buffer_chars = buffer_chars
+        self.max_finished = max_finished
+
+        # task id -> {"text", "start", "end", "closed", "epoch"}
+        self._streams: "OrderedDict[str, dict]" = OrderedDict()
+        self._waiters: Dict[str, Dict[asyncio.Future, None]] = {}
+        self._finished = 0
+
+    def _stream(self, task_id: str) -> dict:
+        stream = self._streams.get(task_id)
+        if stream is None:
+            stream = {"text": "", "start": 0, "end": 0, "closed": False, "epoch": 0}
+            self._streams[task_id] = stream
+        return stream
+
+    def _wake(self, task_id: str):
+        for waiter in self._waiters.pop(task_id, {}):
+            if not waiter.done():
+                waiter.set_result(None)
+
+    def reset(self, task_id: str, epoch: int):
+        """
+        Start a new epoch: drop the task's output and reopen its stream.
+
+        Readers waiting on the stream are woken and see the new epoch.
+
+        Args:
+            task_id: Task being claimed again
+            epoch: The task's claims count
+        """
+        stream = self._stream(task_id)
+        if stream["closed"]:
+            self._finished -= 1
+        stream.update({"text": "", "start": 0, "end": 0, "closed": False, "epoch": epoch})
+        self._streams.move_to_end(task_id)
+        self._wake(task_id)
+
+    def append(self, task_id: str, offset: int, text: str, epoch: Optional[int] = None) -> Optional[int]:
+        """
+        Append output.
+
+        Args:
+            task_id: Task the output belongs to
+            offset: Offset of text's first character in the task's output
+            text: Output
+            epoch: Claim the output was produced under (None = the current one)
+
+        Returns:
+            Offset just past everything received so far, or None if epoch
+            is older than the stream's
+        """
+        stream = self._stream(task_id)
+        if epoch is not None and epoch != stream["epoch"]:
+            if epoch < stream["epoch"]:
+                return None
+            # The stream didn't see the claim (e.g. the server restarted since)
+            self.reset(task_id, epoch)
+        if stream["closed"]:
+            return stream["end"]
+
+        if offset > stream["end"]:
+            # Something was lost in between; keep only what follows the gap
+            stream["text"], stream["start"], stream["end"] = "", offset, offset
+        elif offset < stream["end"]:
+            text = text[stream["end"] - offset:]
+        if not text:
+            return stream["end"]
+
+        stream["text"] += text
+        stream["end"] += len(text)
+        overflow = len(stream["text"]) - self.buffer_chars
+        if overflow > 0:
+            stream["text"] = stream["text"][overflow:]
+            stream["start"] += overflow
+
+        self._wake(task_id)
+        return stream["end"]
+
+    def read(self, task_id: str, offset: int = 0, limit: Optional[int] = None) -> dict:
+        """
+        Read output from an offset.
+
+        Args:
+            task_id: Task to read
+            offset: First character wanted
+            limit: Maximum characters to return
+
+        Returns:
+            Dictionary with text, offset (where text starts), next_offset,
+            truncated (output before offset was dropped), closed and
+            epoch (when it changes, the task was claimed again and its
+            output restarts at offset 0)
+        """
+        stream = self._streams.get(task_id) or {"text": "", "start": 0, "end": 0, "closed": False, "epoch": 0}
+        start = max(offset, stream["start"])
+        text = stream["text"][start - stream["start"]:]
+        if limit is not None:
+            text = text[:limit]
+        return {
+            "text": text,
+            "offset": start,
+            "next_offset": start + len(text),
+            "truncated": offset < stream["start"],
+            "closed": stream["closed"],
+            "epoch": stream["epoch"]
+        }
+
+    async def wait(self, task_id: str, offset: int, timeout: float):
+        """
+        Wait until output past offset arrives, the stream closes or a new epoch starts.
+
+        Args:
+            task_id: Task to watch
+            offset: Offset the caller has read up to
+            timeout: Maximum seconds to wait
+        """
+        stream = self._streams.get(task_id)
+        if timeout <= 0 or (stream is not None and (stream["end"] > offset or stream["closed"])):
+            return
+
+        waiter = asyncio.get_running_loop().create_future()
+        self._waiters.setdefault(task_id, {})[waiter] = None
+        try:
+            await asyncio.wait_for(waiter, timeout=timeout)
+        except asyncio.TimeoutError:
+            pass
+        finally:
+            waiters = self._waiters.get(task_id)
+            if waiters is not None:
+                waiters.pop(waiter, None)
+                if not waiters:
+                    del self._waiters[task_id]
+
+    def close(self, task_id: str):
+        """
+        Mark a task's output finished; readers see closed.
+
+        The oldest finished streams are dropped beyond max_finished.
+        """
+        stream = self._stream(task_id)
+        if not stream["closed"]:
+            stream["closed"] = True
+            self._finished += 1
+        self._streams.move_to_end(task_id)
+        self._wake(task_id)
+
+        while self._finished > self.max_finished:
+            oldest = next((t for t, s in self._streams.items() if s["closed"]), None)
+            if oldest is None:
+                break
+            del self._streams[oldest]
+            self._finished -= 1
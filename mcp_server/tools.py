@@ -4,20 +4,58 @@ MCP Tool Registry and Handlers.
 Defines all tools available to the autonomous development team:
 - analyze_requirements: Break down requirements into project plan
 - create_task: Create a new task
+- create_tasks: Create a batch of tasks (e.g. one plan phase) at once
 - assign_task: Assign task to worker
-- fetch_task: Worker fetches next available task
+- register_worker: Worker announces its type, model and capabilities
+- worker_heartbeat: Worker reports it is alive and learns whether to drain
+- drain_worker: Ask a worker to finish its tasks and exit
+- fetch_task: Worker claims next available task under a lease
 - update_task_status: Update task progress
 - complete_task: Mark task as completed
 - fail_task: Mark task as failed
 - log_event: Universal logging endpoint
 - request_clarification: Worker asks project question
-- get_project_status: Get full project overview
+- get_project_status: Get project overview, optionally only what changed since a version
+- get_scaling_signals: Get ready-queue depth, task durations and worker utilization
+- get_schedule_report: Compare predicted and actual makespan
+- get_conversation: Page through conversation history, optionally for one task
+- wait_for_events: Long-poll for task completion/failure events
+- retry_task: Put a failed task back in the ready queue
+- append_task_output: Worker streams incremental output of a running task
+- get_task_output: Tail a task's live output
+- upload_blob_chunk: Upload one chunk of an artifact
+- commit_blob: Assemble uploaded chunks into an artifact
+- get_blob: Read a byte range of a blob or artifact
 """
 
 from typing import Dict, Any, List, Optional
 from datetime import datetime
+import asyncio
+import base64
+import binascii
 import uuid
 
+from .blobs import MAX_CHUNK_BYTES, offload_large_values
+
+
+# Upper bound on how long a fetch_task or get_project_status long-poll may park on the server
+MAX_FETCH_WAIT_SECONDS = 60.0
+
+# Upper bound on conversation entries returned per get_conversation page
+MAX_CONVERSATION_PAGE = 500
+
+# Upper bound on tasks per create_tasks call
+MAX_BULK_TASKS = 500
+
+# Upper bound on events returned per wait_for_events call
+MAX_EVENTS_PAGE = 500
+
+# Strings in task results longer than this are stored as blobs
+MAX_INLINE_RESULT_CHARS = 16 * 1024
+
+# Upper bound on live output characters returned per get_task_output call
+MAX_OUTPUT_READ_CHARS = 64 * 1024
+
 
 # Tool input schemas (simplified for demonstration)
 class ToolSchema:
@@ -36,14 +74,27 @@ class RequirementsSchema(ToolSchema):
 class TaskCreateSchema(ToolSchema):
     """Schema for create_task tool."""
     properties = {
+        "task_id": {"type": "string"},
         "description": {"type": "string"},
         "dependencies": {"type": "array", "items": {"type": "string"}},
         "required_capabilities": {"type": "array", "items": {"type": "string"}},
-        "estimated_hours": {"type": "number"}
+        "estimated_hours": {"type": "number"},
+        "inputs": {"type": "object", "description": "Extra inputs the result depends on (part of the cache key)"},
+        "cache": {"type": "boolean", "description": "Reuse a cached result of an identical task (default true)"},
+        "phase": {"type": "string", "description": "Plan phase the task belongs to"}
     }
     required = ["description"]
 
 
+class TaskBulkCreateSchema(ToolSchema):
+    """Schema for create_tasks tool."""
+    properties = {
+        "tasks": {"type": "array", "items": {"type": "object", "properties": TaskCreateSchema.properties}, "maxItems": MAX_BULK_TASKS},
+        "phase": {"type": "string", "description": "Plan phase of every task that doesn't name one"}
+    }
+    required = ["tasks"]
+
+
 class TaskAssignSchema(ToolSchema):
     """Schema for assign_task tool."""
     properties = {
@@ -53,11 +104,44 @@ class TaskAssignSchema(ToolSchema):
     required = ["task_id", "worker_id"]
 
 
+class WorkerRegisterSchema(ToolSchema):
+    """Schema for register_worker tool."""
+    properties = {
+        "worker_id": {"type": "string"},
+        "worker_type": {"type": "string"},
+        "capabilities": {"type": "array", "items": {"type": "string"}},
+        "model": {"type": "string"},
+        "max_concurrent_tasks": {"type": "integer", "minimum": 1},
+        "host": {"type": "string"},
+        "pid": {"type": "integer"}
+    }
+    required = ["worker_id", "worker_type", "capabilities"]
+
+
+class WorkerHeartbeatSchema(ToolSchema):
+    """Schema for worker_heartbeat tool."""
+    properties = {
+        "worker_id": {"type": "string"},
+        "status": {"type": "string"},
+        "current_tasks": {"type": "array", "items": {"type": "string"}}
+    }
+    required = ["worker_id", "status"]
+
+
+class WorkerDrainSchema(ToolSchema):
+    """Schema for drain_worker tool."""
+    properties = {
+        "worker_id": {"type": "string"}
+    }
+    required = ["worker_id"]
+
+
 class TaskFetchSchema(ToolSchema):
     """Schema for fetch_task tool."""
     properties = {
         "worker_id": {"type": "string"},
-        "capabilities": {"type": "array", "items": {"type": "string"}}
+        "capabilities": {"type": "array", "items": {"type": "string"}},
+        "wait_seconds": {"type": "number", "minimum": 0}
     }
     required = ["worker_id", "capabilities"]
 
@@ -67,7 +151,8 @@ class TaskStatusSchema(ToolSchema):
     properties = {
         "task_id": {"type": "string"},
         "status": {"type": "string"},
-        "progress": {"type": "integer", "minimum": 0, "maximum": 100}
+        "progress": {"type": "integer", "minimum": 0, "maximum": 100},
+        "worker_id": {"type": "string"}
     }
     required = ["task_id", "status"]
 
@@ -93,10 +178,104 @@ class ClarificationSchema(ToolSchema):
 
 class StatusQuerySchema(ToolSchema):
     """Schema for get_project_status tool."""
+    properties = {
+        "since": {"type": "integer"},
+        "epoch": {"type": "string", "description": "Status epoch since was read in"},
+        "wait_seconds": {"type": "number", "minimum": 0}
+    }
+    required = []
+
+
+class ScalingSignalsSchema(ToolSchema):
+    """Schema for get_scaling_signals tool."""
+    properties = {}
+    required = []
+
+
+class ScheduleReportSchema(ToolSchema):
+    """Schema for get_schedule_report tool."""
     properties = {}
     required = []
 
 
+class TaskOutputAppendSchema(ToolSchema):
+    """Schema for append_task_output tool."""
+    properties = {
+        "task_id": {"type": "string"},
+        "worker_id": {"type": "string"},
+        "offset": {"type": "integer", "minimum": 0},
+        "text": {"type": "string"},
+        "epoch": {"type": "integer", "minimum": 0, "description": "The claims count of the task as fetched"}
+    }
+    required = ["task_id", "worker_id", "offset", "text"]
+
+
+class TaskOutputQuerySchema(ToolSchema):
+    """Schema for get_task_output tool."""
+    properties = {
+        "task_id": {"type": "string"},
+        "offset": {"type": "integer", "minimum": 0},
+        "wait_seconds": {"type": "number", "minimum": 0}
+    }
+    required = ["task_id"]
+
+
+class BlobChunkSchema(ToolSchema):
+    """Schema for upload_blob_chunk tool."""
+    properties = {
+        "data": {"type": "string", "description": "Base64 chunk content", "maxLength": MAX_CHUNK_BYTES * 4 // 3 + 4}
+    }
+    required = ["data"]
+
+
+class BlobCommitSchema(ToolSchema):
+    """Schema for commit_blob tool."""
+    properties = {
+        "chunks": {"type": "array", "items": {"type": "string"}},
+        "media_type": {"type": "string"}
+    }
+    required = ["chunks"]
+
+
+class BlobReadSchema(ToolSchema):
+    """Schema for get_blob tool."""
+    properties = {
+        "blob": {"type": "string"},
+        "chunked": {"type": "boolean"},
+        "offset": {"type": "integer", "minimum": 0},
+        "length": {"type": "integer", "minimum": 1, "maximum": MAX_CHUNK_BYTES}
+    }
+    required = ["blob"]
+
+
+class ConversationQuerySchema(ToolSchema):
+    """Schema for get_conversation tool."""
+    properties = {
+        "task_id": {"type": "string"},
+        "cursor": {"type": "integer"},
+        "limit": {"type": "integer", "minimum": 1, "maximum": MAX_CONVERSATION_PAGE}
+    }
+    required = []
+
+
+class EventQuerySchema(ToolSchema):
+    """Schema for wait_for_events tool."""
+    properties = {
+        "after": {"type": "integer", "minimum": 0},
+        "wait_seconds": {"type": "number", "minimum": 0},
+        "limit": {"type": "integer", "minimum": 1, "maximum": MAX_EVENTS_PAGE}
+    }
+    required = []
+
+
+class TaskRetrySchema(ToolSchema):
+    """Schema for retry_task tool."""
+    properties = {
+        "task_id": {"type": "string"}
+    }
+    required = ["task_id"]
+
+
 # Tool handler functions
 async def analyze_requirements(context_store, params: dict) -> dict:
     """
@@ -130,8 +309,14 @@ async def analyze_requirements(context_store, params: dict) -> dict:
 
 
 async def create_task(context_store, params: dict) -> dict:
-    """Create a new task in the project."""
-    task_id = f"task-{str(uuid.uuid4())[:8]}"
+    """
+    Create a new task in the project.
+
+    Callers may supply task_id so that tasks created in the same batch
+    can name each other in dependencies. An id that is already taken is
+    rejected with duplicate set; the existing task is not changed.
+    """
+    task_id = params.get("task_id") or f"task-{str(uuid.uuid4())[:8]}"
 
     task_data = {
         "description": params.get("description"),
@@ -139,8 +324,18 @@ async def create_task(context_store, params: dict) -> dict:
         "required_capabilities": params.get("required_capabilities", []),
         "estimated_hours": params.get("estimated_hours", 0)
     }
+    for key in ("inputs", "cache", "phase"):
+        if key in params:
+            task_data[key] = params[key]
 
     task = await context_store.create_task(task_id, task_data)
+    if task is None:
+        return {
+            "success": False,
+            "task_id": task_id,
+            "duplicate": True,
+            "message": f"Task {task_id} already exists"
+        }
 
     return {
         "success": True,
@@ -148,6 +343,41 @@ async def create_task(context_store, params: dict) -> dict:
     }
 
 
+async def create_tasks(context_store, params: dict) -> dict:
+    """
+    Create a batch of tasks in one store transaction.
+
+    Tasks may depend on tasks that haven't been created yet (e.g. from a
+    phase still being planned); they stay blocked until those exist and
+    complete. Tasks with a missing description or an id that is already
+    taken are reported in errors (with duplicate set for the latter).
+    """
+    tasks = params.get("tasks", [])
+    if len(tasks) > MAX_BULK_TASKS:
+        return {"success": False, "message": f"At most {MAX_BULK_TASKS} tasks per call"}
+
+    created = []
+    errors = []
+    async with context_store.transaction():
+        for index, task_params in enumerate(tasks):
+            if not task_params.get("description"):
+                errors.append({"index": index, "error": "description is required"})
+                continue
+            if params.get("phase") and "phase" not in task_params:
+                task_params = {**task_params, "phase": params["phase"]}
+            result = await create_task(context_store, task_params)
+            if not result["success"]:
+                errors.append({"index": index, "error": result["message"], "duplicate": True})
+                continue
+            created.append(result["task"])
+
+    return {
+        "success": not errors,
+        "tasks": created,
+        "errors": errors
+    }
+
+
 async def assign_task(context_store, params: dict) -> dict:
     """Assign a task to a specific worker."""
     task_id = params.get("task_id")
@@ -163,27 +393,54 @@ async def assign_task(context_store, params: dict) -> dict:
 
 
 async def fetch_available_task(context_store, params: dict) -> dict:
-    """Worker fetches next available task."""
+    """
+    Worker atomically claims the next available task.
+
+    A claimed task whose result is in the result cache (same inputs,
+    dependency results and worker model) is completed with the cached
+    result on the spot, and the next task is claimed instead.
+    """
     worker_id = params.get("worker_id")
     capabilities = params.get("capabilities", [])
-
-    # Get available tasks matching worker capabilities
-    available_tasks = await context_store.get_available_tasks(capabilities)
-
-    if not available_tasks:
-        return {
-            "success": True,
-            "task": None,
-            "message": "No available tasks"
-        }
-
-    # Assign first available task to this worker
-    task = available_tasks[0]
-    await context_store.assign_task(task["id"], worker_id)
+    wait_seconds = min(float(params.get("wait_seconds", 0)), MAX_FETCH_WAIT_SECONDS)
+    loop = asyncio.get_running_loop()
+    deadline = loop.time() + wait_seconds
+    cached_tasks = []
+
+    while True:
+        # Claim the next ready task matching worker capabilities,
+        # long-polling for up to wait_seconds if none is ready yet
+        remaining = 0 if cached_tasks else max(deadline - loop.time(), 0)
+        task = await context_store.claim_next_task(worker_id, capabilities, remaining)
+        if not task:
+            break
+
+        cached = await context_store.lookup_cached_result(task)
+        if cached is None:
+            return {
+                "success": True,
+                "task": task,
+                "cached_tasks": cached_tasks
+            }
+
+        completed = await context_store.update_task_status(
+            task["id"],
+            "completed",
+            progress=100,
+            result=cached["result"],
+            worker_id=worker_id,
+            cache_hit=True
+        )
+        if completed:
+            # The claim opened an output stream; end it as complete_task does
+            context_store.outputs.close(task["id"])
+        cached_tasks.append(task["id"])
 
     return {
         "success": True,
-        "task": task
+        "task": None,
+        "cached_tasks": cached_tasks,
+        "message": "No available tasks"
     }
 
 
@@ -193,11 +450,15 @@ async def update_task_status(context_store, params: dict) -> dict:
     status = params.get("status")
     progress = params.get("progress")
 
-    success = await context_store.update_task_status(
-        task_id,
-        status,
-        progress=progress
-    )
+    try:
+        success = await context_store.update_task_status(
+            task_id,
+            status,
+            progress=progress,
+            worker_id=params.get("worker_id")
+        )
+    except ValueError as e:
+        return {"success": False, "task_id": task_id, "message": str(e)}
 
     return {
         "success": success,
@@ -207,17 +468,33 @@ async def update_task_status(context_store, params: dict) -> dict:
     }
 
 
+async def _offload(context_store, value):
+    """Move long strings out of a result into the blob store (off the event loop)."""
+    return await asyncio.get_running_loop().run_in_executor(
+        None, offload_large_values, value, context_store.blobs, MAX_INLINE_RESULT_CHARS
+    )
+
+
 async def complete_task(context_store, params: dict) -> dict:
-    """Mark task as completed."""
+    """
+    Mark task as completed.
+
+    Long strings in the result are stored as blobs and replaced by
+    references, so large results don't bloat the task record.
+    """
     task_id = params.get("task_id")
-    result = params.get("result", {})
+    result = await _offload(context_store, params.get("result", {}))
 
     success = await context_store.update_task_status(
         task_id,
         "completed",
         progress=100,
-        result=result
+        result=result,
+        worker_id=params.get("worker_id")
     )
+    if success:
+        context_store.outputs.close(task_id)
+        await context_store.store_cached_result(task_id)
 
     return {
         "success": success,
@@ -234,8 +511,11 @@ async def fail_task(context_store, params: dict) -> dict:
     success = await context_store.update_task_status(
         task_id,
         "failed",
-        result={"error": error}
+        result=await _offload(context_store, {"error": error}),
+        worker_id=params.get("worker_id")
     )
+    if success:
+        context_store.outputs.close(task_id)
 
     return {
         "success": success,
@@ -260,6 +540,60 @@ async def log_event(context_store, params: dict) -> dict:
     }
 
 
+async def register_worker(context_store, params: dict) -> dict:
+    """Register a worker so task matching knows its type, model and capabilities."""
+    worker_id = params.get("worker_id")
+    worker_data = {
+        key: params[key]
+        for key in ("worker_type", "capabilities", "model", "max_concurrent_tasks", "host", "pid")
+        if key in params
+    }
+
+    worker = await context_store.register_worker(worker_id, worker_data)
+
+    return {
+        "success": True,
+        "worker": worker
+    }
+
+
+async def worker_heartbeat(context_store, params: dict) -> dict:
+    """
+    Record a worker heartbeat.
+
+    registered is False when the server has no record of the worker
+    (e.g. after losing its state), telling the worker to register again.
+    current_tasks is diagnostic only: the server tracks which tasks a
+    worker holds from its claims.
+    """
+    try:
+        worker = await context_store.heartbeat_worker(
+            params.get("worker_id"),
+            params.get("status"),
+            params.get("current_tasks", [])
+        )
+    except ValueError as e:
+        return {"success": False, "message": str(e)}
+
+    return {
+        "success": worker is not None,
+        "registered": worker is not None,
+        "drain": bool(worker and worker.get("drain_requested"))
+    }
+
+
+async def drain_worker(context_store, params: dict) -> dict:
+    """Ask a worker to stop taking tasks; it exits once its running tasks finish."""
+    worker_id = params.get("worker_id")
+    success = await context_store.request_drain(worker_id)
+
+    return {
+        "success": success,
+        "worker_id": worker_id,
+        "message": "Drain requested" if success else f"Worker {worker_id} not registered"
+    }
+
+
 async def request_clarification(context_store, params: dict) -> dict:
     """Worker requests clarification from project lead."""
     worker_id = params.get("worker_id")
@@ -285,8 +619,22 @@ async def request_clarification(context_store, params: dict) -> dict:
 
 
 async def get_project_status(context_store, params: dict) -> dict:
-    """Get full project overview."""
-    status = await context_store.get_project_status()
+    """
+    Get project overview.
+
+    With since, only tasks and workers changed after that status version
+    are included; with wait_seconds as well, the call waits for a change.
+    Pass the epoch the version came with: a version from an earlier
+    server run gets a full status with reset set.
+    """
+    since = params.get("since")
+    wait_seconds = min(float(params.get("wait_seconds", 0)), MAX_FETCH_WAIT_SECONDS)
+
+    status = await context_store.get_project_status(
+        since=int(since) if since is not None else None,
+        wait_seconds=wait_seconds,
+        epoch=params.get("epoch")
+    )
 
     return {
         "success": True,
@@ -294,6 +642,193 @@ async def get_project_status(context_store, params: dict) -> dict:
     }
 
 
+async def get_scaling_signals(context_store, params: dict) -> dict:
+    """Get the load signals used to autoscale the worker pool."""
+    signals = await context_store.get_scaling_signals()
+
+    return {
+        "success": True,
+        "signals": signals
+    }
+
+
+async def get_schedule_report(context_store, params: dict) -> dict:
+    """Compare predicted (critical-path) and actual makespan."""
+    report = await context_store.get_schedule_report()
+
+    return {
+        "success": True,
+        "report": report
+    }
+
+
+async def get_conversation(context_store, params: dict) -> dict:
+    """
+    Page through conversation history, oldest first.
+
+    Pass the returned next_cursor back as cursor for the next page;
+    it is None once there is nothing more to read.
+    """
+    cursor = params.get("cursor")
+    limit = max(1, min(int(params.get("limit", 50)), MAX_CONVERSATION_PAGE))
+
+    page = await context_store.get_conversation(
+        task_id=params.get("task_id"),
+        cursor=int(cursor) if cursor is not None else None,
+        limit=limit
+    )
+
+    return {
+        "success": True,
+        **page
+    }
+
+
+async def wait_for_events(context_store, params: dict) -> dict:
+    """
+    Get task events (task_completed, task_failed, all_tasks_terminal) after a cursor.
+
+    With wait_seconds, waits until there is one. Pass the returned next
+    back as after; reset means events were missed and the full status
+    should be checked.
+    """
+    wait_seconds = min(float(params.get("wait_seconds", 0)), MAX_FETCH_WAIT_SECONDS)
+    limit = max(1, min(int(params.get("limit", MAX_EVENTS_PAGE)), MAX_EVENTS_PAGE))
+
+    page = await context_store.wait_for_events(int(params.get("after", 0)), wait_seconds, limit)
+
+    return {
+        "success": True,
+        **page
+    }
+
+
+async def retry_task(context_store, params: dict) -> dict:
+    """Put a failed task back in the ready queue."""
+    task_id = params.get("task_id")
+
+    success = await context_store.retry_task(task_id)
+
+    return {
+        "success": success,
+        "task_id": task_id
+    }
+
+
+async def append_task_output(context_store, params: dict) -> dict:
+    """
+    Worker streams incremental output of a task it holds.
+
+    offset is where text starts in the task's output, so a chunk sent
+    twice is not duplicated. epoch is the task's claims count when the
+    worker fetched it; output from an earlier claim is rejected.
+    """
+    task_id = params.get("task_id")
+    task = await context_store.get_task(task_id)
+    if task is None or task.get("assigned_to") != params.get("worker_id"):
+        return {
+            "success": False,
+            "task_id": task_id,
+            "message": f"Task {task_id} is not held by this worker"
+        }
+
+    epoch = params.get("epoch")
+    end = context_store.outputs.append(
+        task_id,
+        int(params.get("offset", 0)),
+        params.get("text", ""),
+        epoch=int(epoch) if epoch is not None else None
+    )
+    if end is None:
+        return {
+            "success": False,
+            "task_id": task_id,
+            "message": f"Output of task {task_id} is from an earlier claim"
+        }
+
+    return {
+        "success": True,
+        "task_id": task_id,
+        "next_offset": end
+    }
+
+
+async def get_task_output(context_store, params: dict) -> dict:
+    """
+    Tail a task's live output from an offset.
+
+    With wait_seconds, waits for output past offset (or for the task to
+    finish). truncated means output before offset is no longer buffered;
+    the full transcript is in the finished task's result.
+    """
+    task_id = params.get("task_id")
+    offset = int(params.get("offset", 0))
+    wait_seconds = min(float(params.get("wait_seconds", 0)), MAX_FETCH_WAIT_SECONDS)
+
+    await context_store.outputs.wait(task_id, offset, wait_seconds)
+
+    return {
+        "success": True,
+        "task_id": task_id,
+        **context_store.outputs.read(task_id, offset, MAX_OUTPUT_READ_CHARS)
+    }
+
+
+async def upload_blob_chunk(context_store, params: dict) -> dict:
+    """Store one chunk of an artifact; returns its hash for commit_blob."""
+    try:
+        data = base64.b64decode(params.get("data", ""), validate=True)
+    except (binascii.Error, ValueError):
+        return {"success": False, "message": "data is not valid base64"}
+    if len(data) > MAX_CHUNK_BYTES:
+        return {"success": False, "message": f"Chunk exceeds {MAX_CHUNK_BYTES} bytes"}
+
+    digest = await asyncio.get_running_loop().run_in_executor(None, context_store.blobs.put, data)
+
+    return {
+        "success": True,
+        "hash": digest,
+        "size": len(data)
+    }
+
+
+async def commit_blob(context_store, params: dict) -> dict:
+    """Assemble uploaded chunks into an artifact; the reference goes into task results."""
+    try:
+        ref = await asyncio.get_running_loop().run_in_executor(
+            None, context_store.blobs.commit, params.get("chunks", []), params.get("media_type")
+        )
+    except (KeyError, ValueError) as e:
+        return {"success": False, "message": f"Unknown chunk: {e}"}
+
+    return {
+        "success": True,
+        "ref": ref
+    }
+
+
+async def get_blob(context_store, params: dict) -> dict:
+    """Read a byte range of a blob (chunked for artifacts from commit_blob)."""
+    digest = params.get("blob")
+    offset = int(params.get("offset", 0))
+    length = max(1, min(int(params.get("length", MAX_CHUNK_BYTES)), MAX_CHUNK_BYTES))
+
+    try:
+        data = await asyncio.get_running_loop().run_in_executor(
+            None, context_store.blobs.read_artifact, digest, bool(params.get("chunked")), offset, length
+        )
+    except (KeyError, ValueError):
+        return {"success": False, "blob": digest, "message": f"Blob {digest} not found"}
+
+    return {
+        "success": True,
+        "blob": digest,
+        "offset": offset,
+        "data": base64.b64encode(data).decode("ascii"),
+        "eof": len(data) < length
+    }
+
+
 # Tool registry
 TOOLS = {
     "analyze_requirements": {
@@ -306,14 +841,34 @@ TOOLS = {
         "description": "Create a new task in the project",
         "input_schema": TaskCreateSchema
     },
+    "create_tasks": {
+        "handler": create_tasks,
+        "description": "Create a batch of tasks (e.g. one plan phase) in one transaction",
+        "input_schema": TaskBulkCreateSchema
+    },
     "assign_task": {
         "handler": assign_task,
         "description": "Assign task to specific worker",
         "input_schema": TaskAssignSchema
     },
+    "register_worker": {
+        "handler": register_worker,
+        "description": "Register a worker's type, model and capabilities",
+        "input_schema": WorkerRegisterSchema
+    },
+    "worker_heartbeat": {
+        "handler": worker_heartbeat,
+        "description": "Worker reports it is alive and learns whether to drain",
+        "input_schema": WorkerHeartbeatSchema
+    },
+    "drain_worker": {
+        "handler": drain_worker,
+        "description": "Ask a worker to finish its tasks and exit",
+        "input_schema": WorkerDrainSchema
+    },
     "fetch_task": {
         "handler": fetch_available_task,
-        "description": "Worker fetches next available task",
+        "description": "Worker claims next available task under a lease",
         "input_schema": TaskFetchSchema
     },
     "update_task_status": {
@@ -343,8 +898,58 @@ TOOLS = {
     },
     "get_project_status": {
         "handler": get_project_status,
-        "description": "Get full project overview",
+        "description": "Get project overview; with since, only changes after that version",
         "input_schema": StatusQuerySchema
+    },
+    "get_scaling_signals": {
+        "handler": get_scaling_signals,
+        "description": "Get ready-queue depth, task durations and worker utilization",
+        "input_schema": ScalingSignalsSchema
+    },
+    "get_schedule_report": {
+        "handler": get_schedule_report,
+        "description": "Compare predicted (critical-path) and actual makespan",
+        "input_schema": ScheduleReportSchema
+    },
+    "get_conversation": {
+        "handler": get_conversation,
+        "description": "Page through conversation history, optionally for one task",
+        "input_schema": ConversationQuerySchema
+    },
+    "wait_for_events": {
+        "handler": wait_for_events,
+        "description": "Long-poll for task completion and failure events",
+        "input_schema": EventQuerySchema
+    },
+    "retry_task": {
+        "handler": retry_task,
+        "description": "Put a failed task back in the ready queue",
+        "input_schema": TaskRetrySchema
+    },
+    "append_task_output": {
+        "handler": append_task_output,
+        "description": "Worker streams incremental output of a running task",
+        "input_schema": TaskOutputAppendSchema
+    },
+    "get_task_output": {
+        "handler": get_task_output,
+        "description": "Tail a task's live output",
+        "input_schema": TaskOutputQuerySchema
+    },
+    "upload_blob_chunk": {
+        "handler": upload_blob_chunk,
+        "description": "Upload one chunk of an artifact",
+        "input_schema": BlobChunkSchema
+    },
+    "commit_blob": {
+        "handler": commit_blob,
+        "description": "Assemble uploaded chunks into an artifact",
+        "input_schema": BlobCommitSchema
+    },
+    "get_blob": {
+        "handler": get_blob,
+        "description": "Read a byte range of a blob or artifact",
+        "input_schema": BlobReadSchema
     }
 }
 
@@ -15,8 +15,22 @@ import uuid
 from typing import List, Dict, Any, Optional
 from datetime import datetime
 
-from workers.worker import MCPClient
+from workers.mcp_client import MCPClient
 from logging.json_logger import JSONLogger
+from logging.tracing import Tracer
+
+
+# Example decomposition: (key, phase, description, depends on, capabilities, estimated hours)
+EXAMPLE_TASKS = [
+    ("setup", "Planning", "Set up project structure and dependencies", [], ["python", "docker"], 2),
+    ("schema", "Development", "Design and implement database schema", ["setup"], ["postgresql", "python"], 4),
+    ("auth", "Development", "Implement authentication system", ["schema"], ["python", "fastapi", "api_development"], 6),
+    ("api", "Development", "Create API endpoints", ["schema", "auth"], ["python", "fastapi", "api_development"], 8),
+    ("unit_tests", "Testing", "Write unit tests", ["api"], ["pytest", "unittest"], 4),
+    ("integration_tests", "Testing", "Write integration tests", ["api"], ["pytest", "integration_testing"], 4),
+    ("docker", "Deployment", "Set up Docker containerization", ["setup"], ["docker", "deployment"], 3),
+    ("ci_cd", "Deployment", "Create CI/CD pipeline", ["unit_tests", "docker"], ["github_actions", "docker"], 4)
+]
 
 
 class ProjectLead:
@@ -59,12 +73,25 @@ class ProjectLead:
 
         # Initialize logger
         self.logger = JSONLogger("project_lead", "lead-001", log_file)
+        self.tracer = Tracer(self.logger)
 
         # Project state
         self.plan = None
         self.workers = []
         self.is_running = False
         self.tasks_created = []
+        self.schedule_report: Dict[str, Any] = {}
+        # Set once every plan phase has been published; the project can't finish before
+        self.planning_complete = False
+
+        # Event-driven monitoring: cursor into the store's task events,
+        # long-poll length, and how often the full status is checked anyway
+        self.event_cursor = 0
+        self.event_wait_seconds = 30.0
+        self.watchdog_seconds = 60.0
+
+        # Times a failed task is put back in the queue before escalating
+        self.max_task_retries = 1
 
     async def initialize_project(self):
         """
@@ -74,9 +101,18 @@ class ProjectLead:
         1. Log project start
         2. Analyze requirements using MCP
         3. Create project plan
-        4. Decompose into tasks
+        4. Decompose every plan phase concurrently, publishing each
+           phase's tasks as soon as they are produced
         5. Determine worker count
+
+        Workers can start on the first phase's ready tasks while later
+        phases are still being planned.
+
+        Returns:
+            All created tasks
         """
+        self.planning_complete = False
+
         await self.logger.log(
             "project_started",
             {
@@ -125,6 +161,7 @@ class ProjectLead:
 
         # Create tasks from plan
         tasks = await self.create_tasks_from_plan()
+        self.planning_complete = True
 
         await self.logger.log(
             "initialization_complete",
@@ -138,98 +175,118 @@ class ProjectLead:
 
     async def create_tasks_from_plan(self) -> List[dict]:
         """
-        Decompose project plan into atomic tasks.
+        Decompose the plan's phases concurrently and publish their tasks.
 
-        This is a simplified implementation. In production, this would use
-        an AI model to intelligently break down the plan.
+        Each phase is published with one create_tasks call as soon as it
+        is decomposed, rather than after the whole plan. Tasks may depend
+        on tasks of phases that are still being planned; those stay
+        blocked until their dependencies exist and complete.
 
         Returns:
-            List of created tasks
+            List of created tasks, in publication order
         """
+        # Ids are assigned up front so tasks can depend on each other across phases
+        ids = {key: f"task-{str(uuid.uuid4())[:8]}" for key, *_ in EXAMPLE_TASKS}
+
+        phases = [phase["name"] for phase in self.plan.get("phases", [])]
+        # Phases the plan doesn't name still get their tasks
+        phases += sorted({phase for _, phase, *_ in EXAMPLE_TASKS} - set(phases))
+
         tasks = []
+        pending = [
+            asyncio.create_task(self.plan_phase(phase, ids))
+            for phase in phases
+        ]
+        for finished in asyncio.as_completed(pending):
+            tasks.extend(await finished)
 
-        # Example task decomposition based on plan
-        example_tasks = [
-            {
-                "description": "Set up project structure and dependencies",
-                "dependencies": [],
-                "required_capabilities": ["python", "docker"],
-                "estimated_hours": 2
-            },
-            {
-                "description": "Design and implement database schema",
-                "dependencies": [],
-                "required_capabilities": ["postgresql", "python"],
-                "estimated_hours": 4
-            },
-            {
-                "description": "Implement authentication system",
-                "dependencies": [],
-                "required_capabilities": ["python", "fastapi", "api_development"],
-                "estimated_hours": 6
-            },
-            {
-                "description": "Create API endpoints",
-                "dependencies": [],
-                "required_capabilities": ["python", "fastapi", "api_development"],
-                "estimated_hours": 8
-            },
-            {
-                "description": "Write unit tests",
-                "dependencies": [],
-                "required_capabilities": ["pytest", "unittest"],
-                "estimated_hours": 4
-            },
-            {
-                "description": "Write integration tests",
-                "dependencies": [],
-                "required_capabilities": ["pytest", "integration_testing"],
-                "estimated_hours": 4
-            },
-            {
-                "description": "Set up Docker containerization",
-                "dependencies": [],
-                "required_capabilities": ["docker", "deployment"],
-                "estimated_hours": 3
-            },
+        return tasks
+
+    async def decompose_phase(self, phase: str, ids: Dict[str, str]) -> List[dict]:
+        """
+        Decompose one plan phase into atomic tasks.
+
+        This is a simplified implementation. In production, this would use
+        an AI model to intelligently break down the phase.
+
+        Args:
+            phase: Phase name
+            ids: Task id per template key, shared by all phases
+
+        Returns:
+            create_task parameters for the phase's tasks
+        """
+        return [
             {
-                "description": "Create CI/CD pipeline",
-                "dependencies": [],
-                "required_capabilities": ["github_actions", "docker"],
-                "estimated_hours": 4
+                "description": description,
+                "task_id": ids[key],
+                "dependencies": [ids[dep] for dep in depends_on],
+                "required_capabilities": list(capabilities),
+                "estimated_hours": hours,
+                "phase": phase
             }
+            for key, task_phase, description, depends_on, capabilities, hours in EXAMPLE_TASKS
+            if task_phase == phase
         ]
 
-        for task_data in example_tasks:
-            try:
-                result = await self.mcp_client.call_tool(
-                    "create_task",
-                    task_data
-                )
+    async def plan_phase(self, phase: str, ids: Dict[str, str]) -> List[dict]:
+        """
+        Decompose a phase and publish its tasks in one create_tasks call.
 
-                if result.get("success"):
-                    task = result.get("task")
-                    tasks.append(task)
-                    self.tasks_created.append(task["id"])
+        Args:
+            phase: Phase name
+            ids: Task id per template key, shared by all phases
 
-                    await self.logger.log(
-                        "task_created",
-                        {
-                            "task_id": task["id"],
-                            "description": task["description"]
-                        }
-                    )
+        Returns:
+            Created tasks
+        """
+        tasks = []
+        phase_tasks = await self.decompose_phase(phase, ids)
+        if not phase_tasks:
+            return tasks
 
-            except Exception as e:
-                await self.logger.log(
-                    "system_error",
-                    {
-                        "action": "create_task",
-                        "task_data": task_data,
-                        "error": str(e)
-                    },
-                    level="ERROR"
-                )
+        try:
+            result = await self.mcp_client.call_tool(
+                "create_tasks",
+                {"tasks": phase_tasks, "phase": phase}
+            )
+        except Exception as e:
+            await self.logger.log(
+                "system_error",
+                {
+                    "action": "create_tasks",
+                    "phase": phase,
+                    "task_count": len(phase_tasks),
+                    "error": str(e)
+                },
+                level="ERROR"
+            )
+            return tasks
+
+        for task in result.get("tasks", []):
+            tasks.append(task)
+            self.tasks_created.append(task["id"])
+
+            await self.logger.log(
+                "task_created",
+                {
+                    "task_id": task["id"],
+                    "description": task["description"],
+                    "phase": phase
+                }
+            )
+
+        for error in result.get("errors", []):
+            await self.logger.log(
+                "system_error",
+                {
+                    "action": "create_task",
+                    "phase": phase,
+                    "task_data": phase_tasks[error["index"]],
+                    "error": error["error"]
+                },
+                level="ERROR"
+            )
 
         return tasks
 
@@ -262,44 +319,40 @@ class ProjectLead:
 
     async def monitor_progress(self):
         """
-        Continuously monitor project progress.
+        Follow task events until every task is completed or failed.
 
-        Checks status every 10 seconds and logs updates.
+        Completion and failure events are long-polled from the store, so
+        the lead notices the end of the project, and failed tasks, as soon
+        as they happen. A full status check runs every watchdog_seconds,
+        and whenever events were missed, in case the project finished
+        without an event reaching the lead.
         """
+        last_check = None
+        loop = asyncio.get_running_loop()
+
         while self.is_running:
             try:
+                # Short waits while planning, so the end of planning is seen promptly
+                wait_seconds = self.event_wait_seconds if self.planning_complete else 1.0
                 result = await self.mcp_client.call_tool(
-                    "get_project_status",
-                    {}
+                    "wait_for_events",
+                    {"after": self.event_cursor, "wait_seconds": wait_seconds}
                 )
+                self.event_cursor = result.get("next", self.event_cursor)
 
-                status = result.get("status", {})
+                for event in result.get("events", []):
+                    await self.handle_event(event)
+                    if not self.is_running:
+                        return
 
-                await self.logger.log(
-                    "task_progress",
-                    {
-                        "overall_progress": status.get("overall_progress", 0),
-                        "completed_tasks": status.get("metrics", {}).get("completed_tasks", 0),
-                        "total_tasks": status.get("metrics", {}).get("total_tasks", 0),
-                        "active_workers": status.get("active_workers", 0)
-                    }
+                check_due = (
+                    result.get("reset")
+                    or last_check is None
+                    or loop.time() - last_check >= self.watchdog_seconds
                 )
-
-                # Check if all tasks are complete
-                metrics = status.get("metrics", {})
-                if (metrics.get("completed_tasks", 0) + metrics.get("failed_tasks", 0)) >= metrics.get("total_tasks", 0):
-                    if metrics.get("total_tasks", 0) > 0:
-                        await self.logger.log(
-                            "project_completed",
-                            {
-                                "project_id": self.project_id,
-                                "total_tasks": metrics["total_tasks"],
-                                "completed_tasks": metrics["completed_tasks"],
-                                "failed_tasks": metrics["failed_tasks"]
-                            }
-                        )
-                        self.is_running = False
-                        break
+                if check_due and self.planning_complete:
+                    last_check = loop.time()
+                    await self.check_progress()
 
             except Exception as e:
                 await self.logger.log(
@@ -310,42 +363,152 @@ class ProjectLead:
                     },
                     level="ERROR"
                 )
+                await asyncio.sleep(2)  # Back off before retrying
+
+    async def handle_event(self, event: dict):
+        """
+        React to a task event from the store.
+
+        Args:
+            event: Event from wait_for_events
+        """
+        if event["type"] == "task_failed":
+            await self.handle_task_failure(event)
+        elif event["type"] == "all_tasks_terminal" and self.planning_complete:
+            # Confirm against the status: a failure handled just before may have been retried
+            await self.check_progress()
+
+    async def handle_task_failure(self, event: dict):
+        """
+        Reschedule a failed task, or escalate once it has used its retries.
+
+        Args:
+            event: task_failed event
+        """
+        task_id = event["task_id"]
+        if event.get("attempts", 0) < self.max_task_retries:
+            result = await self.mcp_client.call_tool("retry_task", {"task_id": task_id})
+            if result.get("success"):
+                await self.logger.log(
+                    "task_retried",
+                    {
+                        "task_id": task_id,
+                        "attempt": event.get("attempts", 0) + 1,
+                        "error": event.get("error")
+                    },
+                    level="WARNING"
+                )
+                return
+
+        await self.handle_escalation({
+            "task_id": task_id,
+            "worker_id": event.get("worker_id"),
+            "attempts": event.get("attempts", 0) + 1,
+            "error": event.get("error")
+        })
+
+    async def check_progress(self):
+        """Watchdog: log progress from the full status and finish the project if every task is done."""
+        result = await self.mcp_client.call_tool(
+            "get_project_status",
+            {}
+        )
 
-            await asyncio.sleep(10)
+        status = result.get("status", {})
+        metrics = status.get("metrics", {})
+
+        await self.logger.log(
+            "task_progress",
+            {
+                "overall_progress": status.get("overall_progress", 0),
+                "completed_tasks": metrics.get("completed_tasks", 0),
+                "total_tasks": metrics.get("total_tasks", 0),
+                "active_workers": status.get("active_workers", 0)
+            }
+        )
+
+        # Check if all tasks are complete
+        finished = metrics.get("completed_tasks", 0) + metrics.get("failed_tasks", 0)
+        if metrics.get("total_tasks", 0) > 0 and finished >= metrics["total_tasks"]:
+            await self.finish_project(metrics)
+
+    async def finish_project(self, counts: dict):
+        """
+        Log project completion and the schedule report, and stop monitoring.
+
+        Args:
+            counts: total_tasks, completed_tasks and failed_tasks
+        """
+        await self.logger.log(
+            "project_completed",
+            {
+                "project_id": self.project_id,
+                "total_tasks": counts.get("total_tasks", 0),
+                "completed_tasks": counts.get("completed_tasks", 0),
+                "failed_tasks": counts.get("failed_tasks", 0)
+            }
+        )
+        await self.log_schedule_report()
+        self.is_running = False
+
+    async def log_schedule_report(self):
+        """Log predicted (critical-path) versus actual makespan."""
+        try:
+            result = await self.mcp_client.call_tool("get_schedule_report", {})
+            self.schedule_report = result.get("report", {})
+            await self.logger.log("schedule_report", self.schedule_report)
+        except Exception as e:
+            await self.logger.log(
+                "system_error",
+                {
+                    "action": "get_schedule_report",
+                    "error": str(e)
+                },
+                level="ERROR"
+            )
 
     async def run_project(self, workers: List[Any]):
         """
         Run the project with given workers.
 
+        Everything runs inside a "project" span, so the tasks the lead
+        creates, and the workers' execution of them, share its trace.
+
         Args:
             workers: List of Worker instances
         """
         self.workers = workers
         self.is_running = True
 
-        async with self.mcp_client:
-            # Initialize project
-            await self.initialize_project()
+        # One trace for the whole project: planning, task creation and every task below it
+        with self.tracer.span("project", worker_count=len(workers)):
+            async with self.mcp_client:
+                # Plan in the background; workers start on published tasks meanwhile
+                planning = asyncio.create_task(self.initialize_project())
 
-            # Start monitoring
-            await self.logger.log(
-                "task_started",
-                {
-                    "task": "monitor_progress",
-                    "worker_count": len(workers)
-                }
-            )
+                # Start monitoring
+                await self.logger.log(
+                    "task_started",
+                    {
+                        "task": "monitor_progress",
+                        "worker_count": len(workers)
+                    }
+                )
 
-            # Monitor until completion
-            await self.monitor_progress()
+                # Monitor until completion (which waits for planning to finish)
+                try:
+                    await asyncio.gather(planning, self.monitor_progress())
+                except Exception:
+                    self.is_running = False
+                    raise
 
-            await self.logger.log(
-                "task_completed",
-                {
-                    "task": "project_execution",
-                    "status": "completed"
-                }
-            )
+                await self.logger.log(
+                    "task_completed",
+                    {
+                        "task": "project_execution",
+                        "status": "completed"
+                    }
+                )
 
     async def handle_clarification(self, clarification_request: dict) -> str:
         """
@@ -401,5 +564,6 @@ class ProjectLead:
             "plan": self.plan,
             "tasks_created": len(self.tasks_created),
             "workers": len(self.workers),
+            "schedule": self.schedule_report,
             "status": "running" if self.is_running else "completed"
         }
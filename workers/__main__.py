@@ -0,0 +1,6 @@
+"""Run workers as a standalone process: python -m workers --help"""
+
+from .cli import main
+
+
+main()
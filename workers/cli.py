@@ -0,0 +1,239 @@
+"""
+Worker Process Entry Point.
+
+Runs workers outside main.py against a (usually remote) MCP server, so
+workers can be spread across cores and machines:
+
+    python -m workers --mcp-host lead.example --type developer:2 --type tester:1 --processes 4
+
+Each process runs its own event loop with the requested workers. On
+SIGTERM or SIGINT, or when the server drains them, workers stop taking
+tasks and exit once their running tasks finish (or drain_timeout passes,
+after which the server re-leases what was left).
+"""
+
+import argparse
+import asyncio
+import multiprocessing
+import os
+import signal
+import socket
+import sys
+from typing import List, Tuple
+
+from config.settings import ProjectConfig
+from logging.log_writer import close_log_writers, configure_log_writers
+from .mcp_client import close_mcp_sessions, configure_mcp_clients
+from .worker import Worker, WorkerType, create_worker
+
+
+def parse_args(argv=None):
+    """Parse command line arguments."""
+    parser = argparse.ArgumentParser(
+        prog="python -m workers",
+        description="Run autonomous development team workers against an MCP server"
+    )
+
+    parser.add_argument(
+        "--config",
+        type=str,
+        default="config/project_config.json",
+        help="Path to configuration file (default: config/project_config.json)"
+    )
+
+    parser.add_argument(
+        "--mcp-host",
+        type=str,
+        help="MCP server host (overrides config)"
+    )
+
+    parser.add_argument(
+        "--mcp-port",
+        type=int,
+        help="MCP server port (overrides config)"
+    )
+
+    parser.add_argument(
+        "--type",
+        dest="types",
+        action="append",
+        metavar="TYPE[:COUNT]",
+        help="Worker type and count per process, repeatable (default: developer:1)"
+    )
+
+    parser.add_argument(
+        "--processes",
+        type=int,
+        default=1,
+        help="Worker processes to run (default: 1)"
+    )
+
+    parser.add_argument(
+        "--id-prefix",
+        type=str,
+        default=socket.gethostname(),
+        help="Prefix for worker ids, unique per machine (default: hostname)"
+    )
+
+    parser.add_argument(
+        "--drain-timeout",
+        type=float,
+        default=300.0,
+        help="Seconds to wait for running tasks when draining (default: 300)"
+    )
+
+    parser.add_argument(
+        "--log-file",
+        type=str,
+        help="Path to log file (overrides config)"
+    )
+
+    return parser.parse_args(argv)
+
+
+def parse_types(specs: List[str]) -> List[Tuple[WorkerType, int]]:
+    """
+    Parse TYPE[:COUNT] specs.
+
+    Args:
+        specs: Values of --type
+
+    Returns:
+        (worker type, count) pairs
+
+    Raises:
+        ValueError: If a type or count is invalid
+    """
+    parsed = []
+    for spec in specs or ["developer:1"]:
+        name, _, count = spec.partition(":")
+        parsed.append((WorkerType(name), int(count or 1)))
+    return parsed
+
+
+async def run_workers(workers: List[Worker], drain_timeout: float):
+    """
+    Run workers until they all stop, draining them on SIGTERM/SIGINT.
+
+    Args:
+        workers: Workers to run
+        drain_timeout: Seconds to wait for running tasks once draining starts
+    """
+    loop = asyncio.get_running_loop()
+    loops = [asyncio.create_task(worker.work_loop()) for worker in workers]
+    drain_requested = asyncio.Event()
+
+    for sig in (signal.SIGTERM, signal.SIGINT):
+        loop.add_signal_handler(sig, drain_requested.set)
+
+    everything = asyncio.gather(*loops, return_exceptions=True)
+    drain = asyncio.create_task(drain_requested.wait())
+    await asyncio.wait([everything, drain], return_when=asyncio.FIRST_COMPLETED)
+
+    if drain.done():
+        print(f"Draining {len(workers)} workers (up to {drain_timeout:.0f}s)...")
+        for worker in workers:
+            await worker.stop()
+
+        # A second signal skips the wait
+        drain_requested.clear()
+        drain = asyncio.create_task(drain_requested.wait())
+        await asyncio.wait([everything, drain], timeout=drain_timeout, return_when=asyncio.FIRST_COMPLETED)
+
+    drain.cancel()
+    for task in loops:
+        task.cancel()
+    await asyncio.gather(*loops, return_exceptions=True)
+
+
+def run_process(args, process_index: int):
+    """
+    Run one worker process.
+
+    Args:
+        args: Parsed arguments
+        process_index: Index of this process (part of worker ids)
+    """
+    config = ProjectConfig(args.config)
+    mcp_host = args.mcp_host or config.mcp_server_host
+    mcp_port = args.mcp_port or config.mcp_server_port
+    log_file = args.log_file or config.log_file
+
+    os.makedirs(os.path.dirname(log_file) or ".", exist_ok=True)
+    configure_mcp_clients(
+        max_connections=config.mcp_max_connections,
+        request_timeout=config.mcp_request_timeout
+    )
+    # Same writer settings as the server, which shares the log file
+    configure_log_writers(
+        max_queue=config.log_queue_size,
+        flush_bytes=config.log_flush_bytes,
+        flush_interval=config.log_flush_interval_ms / 1000,
+        fsync=config.log_fsync_policy,
+        overflow=config.log_overflow_policy,
+        rotation=config.log_rotation,
+        max_bytes=config.log_max_file_size_mb * 1024 * 1024,
+        retention_days=config.log_retention_days,
+        compression=config.log_compression,
+        index_segments=config.log_index_segments
+    )
+
+    workers = []
+    for worker_type, count in parse_types(args.types):
+        for _ in range(count):
+            worker_id = f"{args.id_prefix}-p{process_index}-{len(workers) + 1:03d}"
+            workers.append(create_worker(worker_id, worker_type, config, mcp_host, mcp_port, log_file))
+
+    print(f"[pid {os.getpid()}] {len(workers)} workers -> {mcp_host}:{mcp_port}: "
+          f"{', '.join(w.worker_id for w in workers)}")
+
+    async def run():
+        try:
+            await run_workers(workers, args.drain_timeout)
+        finally:
+            await close_mcp_sessions()
+
+    try:
+        asyncio.run(run())
+    finally:
+        close_log_writers()
+
+
+def main(argv=None):
+    """Entry point for python -m workers."""
+    args = parse_args(argv)
+
+    try:
+        parse_types(args.types)
+    except ValueError as e:
+        print(f"Error: invalid --type: {e}", file=sys.stderr)
+        sys.exit(2)
+
+    if args.processes <= 1:
+        run_process(args, 0)
+        return
+
+    # Children drain on their own SIGTERM/SIGINT; the parent forwards SIGTERM and waits
+    processes = [
+        multiprocessing.Process(target=run_process, args=(args, i), name=f"workers-{i}")
+        for i in range(args.processes)
+    ]
+    for process in processes:
+        process.start()
+
+    def forward(signum, frame):
+        for process in processes:
+            if process.is_alive() and process.pid:
+                os.kill(process.pid, signal.SIGTERM)
+
+    signal.signal(signal.SIGTERM, forward)
+    signal.signal(signal.SIGINT, lambda signum, frame: None)
+
+    for process in processes:
+        process.join()
+
+    sys.exit(max(abs(p.exitcode or 0) for p in processes))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,652 @@
+"""
+MCP Client for Autonomous Development Team.
+
+Clients talk to the server over HTTP, or through InProcessTransport
+when the server runs in the same process. HTTP clients in a process
+share one pooled aiohttp session per event loop (keep-alive,
+connection limits, DNS cache), and all clients share one circuit
+breaker per server. Calls carry a timeout, optionally bounded by a
+deadline that is also sent to the server, and idempotent tools are
+retried with jittered exponential backoff. The caller's current span
+goes along as a traceparent header (in process, through the context
+variable itself).
+"""
+
+import asyncio
+import contextlib
+import contextvars
+import random
+import time
+from typing import Any, Dict, List, Optional
+
+import aiohttp
+
+from logging import codec
+from logging.tracing import TRACE_HEADER, format_traceparent
+
+
+# Tools that can safely be sent again after a failed attempt
+IDEMPOTENT_TOOLS = {
+    "append_task_output",
+    "commit_blob",
+    "get_blob",
+    "get_conversation",
+    "get_project_status",
+    "get_scaling_signals",
+    "get_schedule_report",
+    "get_task_output",
+    "drain_worker",
+    "register_worker",
+    "update_task_status",
+    "upload_blob_chunk",
+    "wait_for_events",
+    "worker_heartbeat"
+}
+
+# Header carrying the caller's remaining time budget in seconds
+DEADLINE_HEADER = "X-MCP-Timeout"
+
+# Status codes that indicate an overloaded or unreachable server (retried, counted by the breaker)
+RETRYABLE_STATUS = {502, 503, 504}
+
+# Deadline (loop time) inherited by calls made inside deadline_after()
+_current_deadline: contextvars.ContextVar = contextvars.ContextVar("mcp_deadline", default=None)
+
+# Settings applied to sessions and clients created from now on
+_client_options: Dict[str, Any] = {
+    "max_connections": 100,
+    "request_timeout": 30.0,
+    "keepalive_timeout": 30.0,
+    "dns_cache_seconds": 300,
+    "max_retries": 2,
+    "backoff_base": 0.1,
+    "backoff_max": 2.0,
+    "failure_threshold": 5,
+    "reset_timeout": 10.0
+}
+
+# Process-wide pooled sessions, one per event loop, with their user counts
+_sessions: Dict[asyncio.AbstractEventLoop, list] = {}
+
+# Circuit breakers by server base URL
+_breakers: Dict[str, "CircuitBreaker"] = {}
+
+# MCPServers running in this process, by the base URL clients would use
+_in_process_servers: Dict[str, Any] = {}
+
+
+class MCPRequestError(Exception):
+    """Raised when an MCP request fails."""
+
+    def __init__(self, message: str, status: Optional[int] = None):
+        super().__init__(message)
+        self.status = status
+
+
+class CircuitOpenError(MCPRequestError):
+    """Raised without contacting the server while its circuit breaker is open."""
+    pass
+
+
+def configure_mcp_clients(**options):
+    """
+    Set the connection, timeout, retry and breaker options for MCP clients.
+
+    Args:
+        **options: Any of max_connections, request_timeout, keepalive_timeout,
+            dns_cache_seconds, max_retries, backoff_base, backoff_max,
+            failure_threshold, reset_timeout
+    """
+    _client_options.update(options)
+
+
+async def close_mcp_sessions():
+    """Close every pooled session in this process."""
+    sessions = [entry[0] for entry in _sessions.values()]
+    _sessions.clear()
+    for session in sessions:
+        if not session.closed:
+            await session.close()
+
+
+@contextlib.contextmanager
+def deadline_after(seconds: float):
+    """
+    Bound every MCP call made inside the block by a shared deadline.
+
+    Nested scopes can only tighten the deadline.
+
+    Args:
+        seconds: Time budget from now
+    """
+    deadline = asyncio.get_running_loop().time() + seconds
+    outer = _current_deadline.get()
+    token = _current_deadline.set(deadline if outer is None else min(outer, deadline))
+    try:
+        yield
+    finally:
+        _current_deadline.reset(token)
+
+
+def _round_trip(data: Any) -> Any:
+    """Copy a JSON-compatible value the way a request or response would."""
+    return codec.loads(codec.dumps_bytes(data))
+
+
+def _acquire_session() -> aiohttp.ClientSession:
+    """Get this loop's pooled session, creating it on first use."""
+    loop = asyncio.get_running_loop()
+    entry = _sessions.get(loop)
+    if entry is None or entry[0].closed:
+        connector = aiohttp.TCPConnector(
+            limit=_client_options["max_connections"],
+            limit_per_host=_client_options["max_connections"],
+            keepalive_timeout=_client_options["keepalive_timeout"],
+            ttl_dns_cache=_client_options["dns_cache_seconds"],
+            use_dns_cache=True,
+            enable_cleanup_closed=True
+        )
+        entry = [aiohttp.ClientSession(connector=connector), 0]
+        _sessions[loop] = entry
+    entry[1] += 1
+    return entry[0]
+
+
+async def _release_session(session: aiohttp.ClientSession):
+    """Drop one user of a pooled session, closing it with its last user."""
+    for loop, entry in list(_sessions.items()):
+        if entry[0] is session:
+            entry[1] -= 1
+            if entry[1] <= 0:
+                del _sessions[loop]
+                await session.close()
+            return
+
+
+class CircuitBreaker:
+    """
+    Consecutive-failure circuit breaker.
+
+    After failure_threshold failures in a row the circuit opens and calls
+    fail fast for reset_timeout seconds. Then a single probe is let
+    through: success closes the circuit, failure opens it again.
+    """
+
+    def __init__(self, failure_threshold: int = 5, reset_timeout: float = 10.0):
+        """
+        Initialize the breaker.
+
+        Args:
+            failure_threshold: Consecutive failures that open the circuit
+            reset_timeout: Seconds the circuit stays open before a probe
+        """
+        self.failure_threshold = failure_threshold
+        self.reset_timeout = reset_timeout
+        self.failures = 0
+        self.opened_at: Optional[float] = None
+        self._probing = False
+
+    @property
+    def state(self) -> str:
+        """closed, open or half_open."""
+        if self.opened_at is None:
+            return "closed"
+        if time.monotonic() - self.opened_at < self.reset_timeout:
+            return "open"
+        return "half_open"
+
+    def allow(self) -> bool:
+        """Check whether a request may be sent now."""
+        state = self.state
+        if state == "closed":
+            return True
+        if state == "half_open" and not self._probing:
+            self._probing = True
+            return True
+        return False
+
+    def record_success(self):
+        """Close the circuit."""
+        self.failures = 0
+        self.opened_at = None
+        self._probing = False
+
+    def abandon(self):
+        """Forget an in-flight probe whose outcome is unknown (e.g. cancelled)."""
+        self._probing = False
+
+    def record_failure(self):
+        """Count a failure, opening the circuit at the threshold or after a failed probe."""
+        self.failures += 1
+        if self._probing or self.failures >= self.failure_threshold:
+            self.opened_at = time.monotonic()
+        self._probing = False
+
+
+class HTTPTransport:
+    """Sends requests to an MCP server over the process's pooled HTTP session."""
+
+    def __init__(self, base_url: str):
+        """
+        Initialize the transport.
+
+        Args:
+            base_url: Server URL up to and including /v1/mcp
+        """
+        self.base_url = base_url
+        self.session = None
+
+    def open(self):
+        """Join the pooled session."""
+        if not self.session:
+            self.session = _acquire_session()
+
+    async def close(self):
+        """Leave the pooled session."""
+        if self.session:
+            session, self.session = self.session, None
+            await _release_session(session)
+
+    async def send(self, path: str, body: dict, budget: float) -> dict:
+        """
+        POST a JSON body once.
+
+        Args:
+            path: Path below /v1/mcp
+            body: JSON request body
+            budget: Seconds the request may take
+
+        Returns:
+            Decoded JSON response
+
+        Raises:
+            MCPRequestError: If the request fails or times out
+        """
+        self.open()
+
+        url = f"{self.base_url}{path}"
+        headers = {DEADLINE_HEADER: f"{budget:.3f}", "Content-Type": "application/json"}
+        traceparent = format_traceparent()
+        if traceparent:
+            headers[TRACE_HEADER] = traceparent
+
+        try:
+            async with self.session.post(
+                url,
+                data=codec.dumps_bytes(body),
+                headers=headers,
+                timeout=aiohttp.ClientTimeout(total=budget)
+            ) as response:
+                if response.status == 200:
+                    return codec.loads(await response.read())
+                else:
+                    error_text = await response.text()
+                    raise MCPRequestError(f"MCP tool call failed: {error_text}", response.status)
+        except asyncio.TimeoutError:
+            raise MCPRequestError(f"MCP tool call timed out after {budget:.1f}s", 504)
+        except aiohttp.ClientError as e:
+            raise MCPRequestError(f"Network error calling MCP tool: {str(e)}")
+
+
+class InProcessTransport:
+    """
+    Dispatches requests straight to an MCPServer running in this process.
+
+    Tool handlers are called directly, with no HTTP. Params and results
+    are still round-tripped through the codec, so callers and the context
+    store never share mutable records and see exactly what HTTP would
+    deliver.
+    """
+
+    def __init__(self, server):
+        """
+        Initialize the transport.
+
+        Args:
+            server: MCPServer instance (its tools and context store are used directly)
+        """
+        self.server = server
+
+    def open(self):
+        """Nothing to open."""
+        pass
+
+    async def close(self):
+        """Nothing to close."""
+        pass
+
+    async def send(self, path: str, body: dict, budget: float) -> dict:
+        """
+        Execute a request in process.
+
+        Args:
+            path: Path below /v1/mcp (/tools/<name> or /batch)
+            body: Request body as it would be sent over HTTP
+            budget: Seconds the caller will wait (bounds long-polls)
+
+        Returns:
+            Response body as it would be received over HTTP
+
+        Raises:
+            MCPRequestError: If the tool is unknown or fails
+        """
+        body = _round_trip(body)
+
+        if path == "/batch":
+            results = await self.server.run_batch(
+                body.get("calls", []), body.get("stop_on_error", False), "in_process", budget=budget
+            )
+            return _round_trip({"success": True, "results": results})
+
+        tool_name = path.rsplit("/", 1)[-1]
+        try:
+            result = await self.server.call_tool_local(tool_name, body.get("params", {}), budget)
+        except KeyError as e:
+            raise MCPRequestError(f"MCP tool call failed: {e.args[0]}", 404)
+        except Exception as e:
+            raise MCPRequestError(f"MCP tool call failed: {str(e)}", 500)
+        return _round_trip(result)
+
+
+def register_in_process_server(server, mcp_host: str, mcp_port: int):
+    """
+    Route MCP clients for host:port created from now on to a server in this process.
+
+    Args:
+        server: MCPServer instance
+        mcp_host: Host the clients are configured with
+        mcp_port: Port the clients are configured with
+    """
+    _in_process_servers[f"http://{mcp_host}:{mcp_port}/v1/mcp"] = server
+
+
+def unregister_in_process_server(mcp_host: str, mcp_port: int):
+    """Send clients for host:port created from now on over HTTP again."""
+    _in_process_servers.pop(f"http://{mcp_host}:{mcp_port}/v1/mcp", None)
+
+
+class MCPClient:
+    """
+    Simple MCP client for communicating with MCP server.
+
+    Calls go over HTTP, or straight to the server's handlers when it
+    was registered in this process with register_in_process_server.
+
+    Besides single tool calls, supports explicit batches and a
+    coalescing queue: calls queued with queue_tool are held for
+    coalesce_window seconds, later calls with the same key replace
+    earlier ones, and the survivors are sent as one batch.
+    """
+
+    def __init__(
+        self,
+        mcp_host: str = "localhost",
+        mcp_port: int = 8080,
+        coalesce_window: float = 0.25,
+        transport=None
+    ):
+        """
+        Initialize MCP client.
+
+        Args:
+            mcp_host: MCP server host
+            mcp_port: MCP server port
+            coalesce_window: Seconds queued calls wait before being flushed
+            transport: HTTPTransport or InProcessTransport (chosen from the
+                in-process server registry if omitted)
+        """
+        self.base_url = f"http://{mcp_host}:{mcp_port}/v1/mcp"
+        self.coalesce_window = coalesce_window
+        self.request_timeout = _client_options["request_timeout"]
+        self.max_retries = _client_options["max_retries"]
+
+        if transport is None:
+            server = _in_process_servers.get(self.base_url)
+            transport = InProcessTransport(server) if server else HTTPTransport(self.base_url)
+        self.transport = transport
+
+        self.breaker = _breakers.get(self.base_url)
+        if self.breaker is None:
+            self.breaker = CircuitBreaker(
+                _client_options["failure_threshold"],
+                _client_options["reset_timeout"]
+            )
+            _breakers[self.base_url] = self.breaker
+
+        # Queued calls keyed by (tool_name, key), in first-queued order
+        self._queued: Dict[Any, tuple] = {}
+        self._flush_timer = None
+        self._flush_lock = asyncio.Lock()
+
+    async def __aenter__(self):
+        """Open the transport on context enter."""
+        self.transport.open()
+        return self
+
+    async def __aexit__(self, exc_type, exc_val, exc_tb):
+        """Flush queued calls and close the transport on context exit."""
+        try:
+            await self.flush()
+        finally:
+            await self.close()
+
+    async def close(self):
+        """Close the transport."""
+        await self.transport.close()
+
+    def _budget(self, timeout: Optional[float], deadline: Optional[float]) -> float:
+        """Seconds left for a call given its timeout and any deadline in scope."""
+        loop = asyncio.get_running_loop()
+        budget = timeout if timeout is not None else self.request_timeout
+        for limit in (deadline, _current_deadline.get()):
+            if limit is not None:
+                budget = min(budget, limit - loop.time())
+        return budget
+
+    async def _post(
+        self,
+        path: str,
+        body: dict,
+        idempotent: bool = False,
+        timeout: Optional[float] = None,
+        deadline: Optional[float] = None
+    ) -> dict:
+        """
+        POST a JSON body to the MCP server.
+
+        Args:
+            path: Path below /v1/mcp
+            body: JSON request body
+            idempotent: Whether the request may be retried
+            timeout: Seconds the call may take including retries (defaults to request_timeout)
+            deadline: Loop time by which the call must finish
+
+        Returns:
+            Decoded JSON response
+
+        Raises:
+            CircuitOpenError: If the server's circuit breaker is open
+            MCPRequestError: If the request fails
+        """
+        loop = asyncio.get_running_loop()
+        call_deadline = loop.time() + self._budget(timeout, deadline)
+        attempt = 0
+
+        while True:
+            budget = call_deadline - loop.time()
+            if budget <= 0:
+                raise MCPRequestError("MCP call deadline exceeded", 504)
+            if not self.breaker.allow():
+                raise CircuitOpenError(f"MCP server at {self.base_url} is unavailable (circuit open)", 503)
+
+            try:
+                result = await self.transport.send(path, body, budget)
+                self.breaker.record_success()
+                return result
+            except MCPRequestError as e:
+                transient = e.status is None or e.status in RETRYABLE_STATUS
+                if transient:
+                    self.breaker.record_failure()
+                else:
+                    # The server answered; it is healthy even if the call was refused
+                    self.breaker.record_success()
+
+                if not (transient and idempotent and attempt < self.max_retries):
+                    raise
+            except asyncio.CancelledError:
+                self.breaker.abandon()
+                raise
+
+            # Full jitter: sleep uniformly up to the capped exponential delay
+            delay = random.uniform(0, min(
+                _client_options["backoff_max"],
+                _client_options["backoff_base"] * 2 ** attempt
+            ))
+            if loop.time() + delay >= call_deadline:
+                raise MCPRequestError("MCP call deadline exceeded", 504)
+            await asyncio.sleep(delay)
+            attempt += 1
+
+    async def call_tool(
+        self,
+        tool_name: str,
+        params: dict,
+        timeout: Optional[float] = None,
+        deadline: Optional[float] = None
+    ) -> dict:
+        """
+        Call an MCP tool.
+
+        Queued calls are flushed first so the server sees calls in order.
+        They are advisory, so a failed flush is logged and the call is
+        still sent. Long-polling calls get their wait_seconds on top of
+        the timeout.
+
+        Args:
+            tool_name: Name of the tool
+            params: Tool parameters
+            timeout: Seconds the call may take (defaults to request_timeout)
+            deadline: Loop time by which the call must finish
+
+        Returns:
+            Tool result
+
+        Raises:
+            Exception: If tool call fails
+        """
+        await self._flush_before_call()
+
+        if timeout is None:
+            timeout = self.request_timeout + float(params.get("wait_seconds", 0))
+
+        return await self._post(
+            f"/tools/{tool_name}",
+            {"params": params},
+            idempotent=tool_name in IDEMPOTENT_TOOLS,
+            timeout=timeout,
+            deadline=deadline
+        )
+
+    async def call_tools_batch(
+        self,
+        calls: List[tuple],
+        stop_on_error: bool = False,
+        timeout: Optional[float] = None,
+        deadline: Optional[float] = None
+    ) -> List[dict]:
+        """
+        Call several MCP tools in one request and one server transaction.
+
+        Queued calls are flushed first, as for call_tool (a failed flush
+        is logged and the batch still sent). The batch is retried only if
+        every call in it is idempotent.
+
+        Args:
+            calls: Ordered list of (tool_name, params) tuples
+            stop_on_error: Stop executing at the first failing call
+            timeout: Seconds the batch may take (defaults to request_timeout)
+            deadline: Loop time by which the batch must finish
+
+        Returns:
+            One entry per executed call: {"tool", "result"} or {"tool", "error"}
+
+        Raises:
+            Exception: If the batch request itself fails
+        """
+        if not calls:
+            return []
+
+        await self._flush_before_call()
+        return await self._send_batch(calls, stop_on_error, timeout, deadline)
+
+    async def _send_batch(
+        self,
+        calls: List[tuple],
+        stop_on_error: bool = False,
+        timeout: Optional[float] = None,
+        deadline: Optional[float] = None
+    ) -> List[dict]:
+        """Send calls as one batch request (see call_tools_batch)."""
+        response = await self._post(
+            "/batch",
+            {
+                "calls": [{"tool": name, "params": params} for name, params in calls],
+                "stop_on_error": stop_on_error
+            },
+            idempotent=all(name in IDEMPOTENT_TOOLS for name, _ in calls),
+            timeout=timeout,
+            deadline=deadline
+        )
+        return response.get("results", [])
+
+    def queue_tool(self, tool_name: str, params: dict, key: Optional[str] = None):
+        """
+        Queue a fire-and-forget tool call for coalesced delivery.
+
+        Suitable for advisory calls such as progress updates.
+
+        Args:
+            tool_name: Name of the tool
+            params: Tool parameters
+            key: Coalescing key; a newer call with the same tool and key
+                replaces the queued one (None never coalesces)
+        """
+        queue_key = (tool_name, key) if key is not None else (tool_name, object())
+        self._queued.pop(queue_key, None)
+        self._queued[queue_key] = (tool_name, params)
+
+        if self._flush_timer is None:
+            self._flush_timer = asyncio.create_task(self._flush_later())
+
+    async def _flush_later(self):
+        """Flush the queue after the coalescing window."""
+        await asyncio.sleep(self.coalesce_window)
+        self._flush_timer = None
+        try:
+            await self.flush()
+        except Exception:
+            # Queued calls are advisory; the next flush carries newer state
+            pass
+
+    async def flush(self):
+        """Send all queued calls as a single batch."""
+        if self._flush_timer is not None and self._flush_timer is not asyncio.current_task():
+            self._flush_timer.cancel()
+            self._flush_timer = None
+
+        # Serialized so a direct call never overtakes a batch in flight
+        async with self._flush_lock:
+            if not self._queued:
+                return
+
+            calls = list(self._queued.values())
+            self._queued.clear()
+            await self._send_batch(calls)
+
+    async def _flush_before_call(self):
+        """Flush queued calls ahead of a direct call, logging (not raising) a failure."""
+        try:
+            await self.flush()
+        except Exception as e:
+            # Queued calls are advisory; losing them must not cost the call that follows
+            print(f"Warning: Failed to send queued MCP calls: {e}")
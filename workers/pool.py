@@ -0,0 +1,307 @@
+"""
+Worker Pool for Autonomous Development Team.
+
+Runs the worker loops and, when auto-scaling is enabled, grows and
+shrinks the pool at runtime from the server's load signals.
+"""
+
+import asyncio
+import time
+import traceback
+from typing import Callable, Dict, List, Optional, Set, Tuple
+
+from .mcp_client import MCPClient
+from .worker import Worker, WorkerCapabilities, WorkerType
+from logging.json_logger import JSONLogger
+
+
+# Ready-queue bucket for tasks that don't require any capability (matches the context store)
+ANY_CAPABILITY = "*"
+
+
+class WorkerPool:
+    """
+    Pool of workers with an optional auto-scaling controller.
+
+    Every interval the controller fetches get_scaling_signals and:
+    - scales up when the ready backlog of some capability (ready tasks
+      beyond the free slots of matching workers) would take longer than
+      target_drain_seconds to clear at the observed task duration,
+      spawning the profile type that covers that capability with the
+      most slots
+    - scales down a worker that has held no task for idle_seconds,
+      as long as nothing it could take is waiting
+
+    The pool stays between min_workers and max_workers and changes by
+    at most one worker per cooldown_seconds.
+    """
+
+    def __init__(
+        self,
+        worker_factory: Callable[[str, WorkerType], Worker],
+        min_workers: int = 2,
+        max_workers: int = 8,
+        mcp_host: str = "localhost",
+        mcp_port: int = 8080,
+        log_file: str = "logs/project_activity.log",
+        interval: float = 5.0,
+        target_drain_seconds: float = 60.0,
+        idle_seconds: float = 60.0,
+        cooldown_seconds: float = 15.0,
+        default_task_seconds: float = 30.0
+    ):
+        """
+        Initialize the pool.
+
+        Args:
+            worker_factory: Creates a worker from (worker_id, worker_type)
+            min_workers: Lower bound on pool size
+            max_workers: Upper bound on pool size
+            mcp_host: MCP server host
+            mcp_port: MCP server port
+            log_file: Path to log file
+            interval: Seconds between scaling decisions
+            target_drain_seconds: Acceptable time to clear a capability's backlog
+            idle_seconds: How long a worker may hold no task before it is retired
+            cooldown_seconds: Minimum time between two scaling actions
+            default_task_seconds: Assumed task duration before any has completed
+        """
+        self.worker_factory = worker_factory
+        self.min_workers = min_workers
+        self.max_workers = max_workers
+        self.interval = interval
+        self.target_drain_seconds = target_drain_seconds
+        self.idle_seconds = idle_seconds
+        self.cooldown_seconds = cooldown_seconds
+        self.default_task_seconds = default_task_seconds
+
+        self.mcp_client = MCPClient(mcp_host, mcp_port)
+        self.logger = JSONLogger("project_lead", "autoscaler", log_file)
+
+        # Shared with the lead and display; workers retired by scaling are removed once drained
+        self.workers: List[Worker] = []
+        self.worker_tasks: Dict[str, asyncio.Task] = {}
+        self._next_id = 1
+        self._idle_since: Dict[str, float] = {}
+        self._retiring: Set[str] = set()
+        self._last_action = 0.0
+
+    def add_worker(self, worker: Worker):
+        """
+        Add a worker and start its work loop.
+
+        Args:
+            worker: Worker instance
+        """
+        self.workers.append(worker)
+        self._next_id = max(self._next_id, self._worker_number(worker.worker_id) + 1)
+
+        loop_task = asyncio.create_task(worker.work_loop())
+        loop_task.add_done_callback(lambda _, worker=worker: self._forget(worker))
+        self.worker_tasks[worker.worker_id] = loop_task
+
+    def spawn(self, worker_type: WorkerType) -> Worker:
+        """
+        Create and start a new worker of a type.
+
+        Args:
+            worker_type: Worker type
+
+        Returns:
+            The new worker
+        """
+        worker = self.worker_factory(f"worker-{self._next_id:03d}", worker_type)
+        self.add_worker(worker)
+        return worker
+
+    async def retire(self, worker: Worker):
+        """
+        Stop a worker; it leaves the pool once its in-flight tasks finish.
+
+        Args:
+            worker: Worker to stop
+        """
+        self._retiring.add(worker.worker_id)
+        await worker.stop()
+
+    async def stop(self):
+        """Stop every worker in the pool."""
+        for worker in list(self.workers):
+            await worker.stop()
+
+    def _forget(self, worker: Worker):
+        """Drop a retired worker from the pool once its loop has exited."""
+        if worker.worker_id not in self._retiring:
+            return
+        self._retiring.discard(worker.worker_id)
+        if worker in self.workers:
+            self.workers.remove(worker)
+        self.worker_tasks.pop(worker.worker_id, None)
+        self._idle_since.pop(worker.worker_id, None)
+
+    @staticmethod
+    def _worker_number(worker_id: str) -> int:
+        """Numeric suffix of a worker-NNN id (0 if there is none)."""
+        suffix = worker_id.rsplit("-", 1)[-1]
+        return int(suffix) if suffix.isdigit() else 0
+
+    @property
+    def active_workers(self) -> List[Worker]:
+        """Workers that have not been stopped."""
+        return [w for w in self.workers if w.is_active]
+
+    @staticmethod
+    def _serves(worker: Worker, capability: str) -> bool:
+        """Check whether a worker can take tasks from a capability bucket."""
+        return capability == ANY_CAPABILITY or capability in worker.capabilities
+
+    @staticmethod
+    def profile_for(capability: str) -> Optional[WorkerType]:
+        """
+        Pick the worker type to spawn for a capability bottleneck.
+
+        Args:
+            capability: Required capability (or "*" for any)
+
+        Returns:
+            Type covering the capability with the most slots, or None if no type has it
+        """
+        if capability == ANY_CAPABILITY:
+            return WorkerType.DEVELOPER
+
+        candidates = [
+            (profile["max_concurrent_tasks"], worker_type)
+            for worker_type, profile in WorkerCapabilities.PROFILES.items()
+            if capability in profile["capabilities"]
+        ]
+        if not candidates:
+            return None
+        return max(candidates, key=lambda c: c[0])[1]
+
+    def find_bottleneck(self, signals: dict) -> Optional[Tuple[str, float]]:
+        """
+        Find the capability whose backlog would take longest to drain.
+
+        Args:
+            signals: Result of get_scaling_signals
+
+        Returns:
+            (capability, estimated drain seconds) above target_drain_seconds, or None
+        """
+        durations = signals.get("task_duration_seconds", {})
+        worst = None
+
+        for capability, depth in signals.get("ready_by_capability", {}).items():
+            serving = [w for w in self.active_workers if self._serves(w, capability)]
+            free = sum(w.max_concurrent_tasks - len(w.current_tasks) for w in serving)
+            backlog = depth - free
+            if backlog <= 0:
+                continue
+
+            slots = sum(w.max_concurrent_tasks for w in serving)
+            drain = backlog * durations.get(capability, self.default_task_seconds) / max(slots, 1)
+            if drain > self.target_drain_seconds and (worst is None or drain > worst[1]):
+                worst = (capability, drain)
+
+        return worst
+
+    def find_idle_worker(self, signals: dict) -> Optional[Worker]:
+        """
+        Pick a worker to retire.
+
+        Args:
+            signals: Result of get_scaling_signals
+
+        Returns:
+            The longest-idle worker past idle_seconds with no matching ready work, or None
+        """
+        now = time.monotonic()
+        ready = signals.get("ready_by_capability", {})
+        oldest = None
+
+        for worker in self.active_workers:
+            if worker.current_tasks:
+                self._idle_since.pop(worker.worker_id, None)
+                continue
+
+            since = self._idle_since.setdefault(worker.worker_id, now)
+            if now - since < self.idle_seconds:
+                continue
+            if any(self._serves(worker, cap) and depth > 0 for cap, depth in ready.items()):
+                continue
+            if oldest is None or since < self._idle_since[oldest.worker_id]:
+                oldest = worker
+
+        return oldest
+
+    async def scale_once(self, signals: dict) -> Optional[str]:
+        """
+        Make one scaling decision and apply it.
+
+        Args:
+            signals: Result of get_scaling_signals
+
+        Returns:
+            "up", "down" or None
+        """
+        now = time.monotonic()
+        active = self.active_workers
+
+        # Track idleness every round so the idle clock is accurate
+        idle_worker = self.find_idle_worker(signals)
+
+        if now - self._last_action < self.cooldown_seconds:
+            return None
+
+        bottleneck = self.find_bottleneck(signals)
+        if bottleneck and len(active) < self.max_workers:
+            capability, drain = bottleneck
+            worker_type = self.profile_for(capability)
+            if worker_type is not None:
+                worker = self.spawn(worker_type)
+                self._last_action = now
+                await self.logger.log("worker_scaled", {
+                    "direction": "up",
+                    "worker_id": worker.worker_id,
+                    "worker_type": worker_type.value,
+                    "capability": capability,
+                    "estimated_drain_seconds": round(drain, 1),
+                    "pool_size": len(self.active_workers)
+                })
+                return "up"
+
+        if not bottleneck and idle_worker is not None and len(active) > self.min_workers:
+            # retire() forgets the worker's idle clock, so read it first
+            idle_seconds = now - self._idle_since.get(idle_worker.worker_id, now)
+            await self.retire(idle_worker)
+            self._last_action = now
+            await self.logger.log("worker_scaled", {
+                "direction": "down",
+                "worker_id": idle_worker.worker_id,
+                "worker_type": idle_worker.worker_type.value,
+                "idle_seconds": round(idle_seconds, 1),
+                "pool_size": len(self.active_workers)
+            })
+            return "down"
+
+        return None
+
+    async def autoscale(self):
+        """Run the scaling controller until cancelled."""
+        async with self.mcp_client:
+            while True:
+                try:
+                    result = await self.mcp_client.call_tool("get_scaling_signals", {})
+                    await self.scale_once(result.get("signals", {}))
+                except Exception as e:
+                    await self.logger.log(
+                        "system_error",
+                        {
+                            "action": "autoscale",
+                            "error": str(e),
+                            "stack_trace": traceback.format_exc()
+                        },
+                        level="ERROR"
+                    )
+
+                await asyncio.sleep(self.interval)
@@ -6,12 +6,23 @@ Different worker types have different capabilities and models.
 """
 
 import asyncio
+import base64
+import os
+import socket
 import traceback
 from enum import Enum
 from typing import List, Optional, Dict, Any
-import aiohttp
 
 from logging.json_logger import JSONLogger
+from logging.tracing import Tracer
+from .mcp_client import MCPClient
+
+
+# Bytes per upload_blob_chunk call (well under the server's 1MB limit once base64-encoded)
+UPLOAD_CHUNK_BYTES = 256 * 1024
+
+# Artifact contents longer than this are uploaded as blobs instead of sent inline
+MAX_INLINE_ARTIFACT_CHARS = 16 * 1024
 
 
 class WorkerType(Enum):
@@ -22,6 +33,21 @@ class WorkerType(Enum):
     ARCHITECT = "architect"
 
 
+class LeaseLostError(Exception):
+    """Raised when the server has reclaimed a task from this worker."""
+    pass
+
+
+class TaskTimeoutError(Exception):
+    """Raised when a task runs past its timeout_seconds."""
+    pass
+
+
+class TaskCancelledError(Exception):
+    """Raised when a running task is cancelled through Worker.cancel_task."""
+    pass
+
+
 class WorkerCapabilities:
     """Define capabilities for each worker type."""
 
@@ -53,68 +79,16 @@ class WorkerCapabilities:
     }
 
 
-class MCPClient:
-    """Simple MCP client for communicating with MCP server."""
-
-    def __init__(self, mcp_host: str = "localhost", mcp_port: int = 8080):
-        """
-        Initialize MCP client.
-
-        Args:
-            mcp_host: MCP server host
-            mcp_port: MCP server port
-        """
-        self.base_url = f"http://{mcp_host}:{mcp_port}/v1/mcp"
-        self.session = None
-
-    async def __aenter__(self):
-        """Create session on context enter."""
-        self.session = aiohttp.ClientSession()
-        return self
-
-    async def __aexit__(self, exc_type, exc_val, exc_tb):
-        """Close session on context exit."""
-        if self.session:
-            await self.session.close()
-
-    async def call_tool(self, tool_name: str, params: dict) -> dict:
-        """
-        Call an MCP tool.
-
-        Args:
-            tool_name: Name of the tool
-            params: Tool parameters
-
-        Returns:
-            Tool result
-
-        Raises:
-            Exception: If tool call fails
-        """
-        if not self.session:
-            self.session = aiohttp.ClientSession()
-
-        url = f"{self.base_url}/tools/{tool_name}"
-
-        try:
-            async with self.session.post(url, json={"params": params}) as response:
-                if response.status == 200:
-                    return await response.json()
-                else:
-                    error_text = await response.text()
-                    raise Exception(f"MCP tool call failed: {error_text}")
-        except aiohttp.ClientError as e:
-            raise Exception(f"Network error calling MCP tool: {str(e)}")
-
-
 class Worker:
     """
     Worker that executes tasks from the project queue.
 
     Workers:
     - Fetch available tasks based on their capabilities
+    - Execute up to max_concurrent_tasks tasks at once, one per slot
     - Execute tasks with progress reporting
     - Handle errors and escalate to project lead
+    - Send heartbeats, and drain when the server asks them to
     - Log all activity
     """
 
@@ -124,7 +98,10 @@ class Worker:
         worker_type: WorkerType,
         mcp_host: str = "localhost",
         mcp_port: int = 8080,
-        log_file: str = "logs/project_activity.log"
+        log_file: str = "logs/project_activity.log",
+        max_concurrent_tasks: Optional[int] = None,
+        timeout_seconds: Optional[int] = None,
+        heartbeat_seconds: float = 10.0
     ):
         """
         Initialize worker.
@@ -135,6 +112,9 @@ class Worker:
             mcp_host: MCP server host
             mcp_port: MCP server port
             log_file: Path to log file
+            max_concurrent_tasks: Task slots (defaults to the type's profile)
+            timeout_seconds: Per-task time limit (defaults to the type's profile)
+            heartbeat_seconds: Interval between heartbeats to the server
         """
         self.worker_id = worker_id
         self.worker_type = worker_type
@@ -142,18 +122,29 @@ class Worker:
         # Get capabilities from profile
         profile = WorkerCapabilities.PROFILES[worker_type]
         self.capabilities = profile["capabilities"]
-        self.max_concurrent_tasks = profile["max_concurrent_tasks"]
+        self.max_concurrent_tasks = max(1, max_concurrent_tasks or profile["max_concurrent_tasks"])
         self.model = profile["model"]
-        self.timeout_seconds = profile["timeout_seconds"]
+        self.timeout_seconds = timeout_seconds or profile["timeout_seconds"]
 
         # Initialize MCP client
         self.mcp_client = MCPClient(mcp_host, mcp_port)
 
         # Initialize logger
         self.logger = JSONLogger("worker", worker_id, log_file)
-
-        # Worker state
-        self.current_task = None
+        self.tracer = Tracer(self.logger)
+
+        # How long a fetch_task call may park on the server waiting for work
+        self.fetch_wait_seconds = 20.0
+        self.heartbeat_seconds = heartbeat_seconds
+
+        # Worker state: one entry per occupied slot, in claim order
+        self.slots = asyncio.Semaphore(self.max_concurrent_tasks)
+        self.current_tasks: Dict[str, dict] = {}
+        self._slot_runners: Dict[str, asyncio.Task] = {}
+        self._slot_work: Dict[str, asyncio.Task] = {}
+        # task id -> output emitted so far (uploaded as the full transcript on completion)
+        self._outputs: Dict[str, List[str]] = {}
+        self._output_offsets: Dict[str, int] = {}
         self.is_active = True
         self.tasks_completed = 0
         self.tasks_failed = 0
@@ -169,7 +160,7 @@ class Worker:
             }
         )
 
-        # Register with MCP server
+        await self.register()
         await self.mcp_client.call_tool(
             "log_event",
             {
@@ -182,47 +173,249 @@ class Worker:
             }
         )
 
+    async def register(self):
+        """Register with the MCP server (type and model feed task matching)."""
+        await self.mcp_client.call_tool(
+            "register_worker",
+            {
+                "worker_id": self.worker_id,
+                "worker_type": self.worker_type.value,
+                "capabilities": self.capabilities,
+                "model": self.model,
+                "max_concurrent_tasks": self.max_concurrent_tasks,
+                "host": socket.gethostname(),
+                "pid": os.getpid()
+            }
+        )
+
+    async def heartbeat(self) -> dict:
+        """
+        Report status and running tasks to the MCP server.
+
+        Returns:
+            Heartbeat result (registered, drain)
+        """
+        return await self.mcp_client.call_tool(
+            "worker_heartbeat",
+            {
+                "worker_id": self.worker_id,
+                "status": self.status.lower(),
+                "current_tasks": list(self.current_tasks)
+            }
+        )
+
+    async def _heartbeat_loop(self):
+        """Send heartbeats until cancelled; re-register if forgotten, stop if drained."""
+        while True:
+            await asyncio.sleep(self.heartbeat_seconds)
+            try:
+                result = await self.heartbeat()
+                if not result.get("registered", True):
+                    await self.register()
+                elif result.get("drain") and self.is_active:
+                    await self.logger.log("worker_draining", {"running_tasks": list(self.current_tasks)})
+                    await self.stop()
+            except Exception as e:
+                await self.logger.log(
+                    "system_error",
+                    {
+                        "action": "heartbeat",
+                        "error": str(e)
+                    },
+                    level="WARNING"
+                )
+
     async def work_loop(self):
         """
         Continuous task execution loop.
 
         Worker continuously:
-        1. Fetches next available task
-        2. Executes task with progress updates
-        3. Reports completion or failure
-        4. Repeats until stopped
+        1. Waits for a free slot
+        2. Fetches next available task
+        3. Executes it in that slot with progress updates
+        4. Reports completion or failure and frees the slot
+        5. Repeats until stopped
+
+        In-flight tasks are allowed to finish once the worker is stopped,
+        and are cancelled if the loop itself is cancelled. Heartbeats run
+        alongside, and a final one reports the worker stopped.
         """
         async with self.mcp_client:
             await self.start()
+            heartbeats = asyncio.create_task(self._heartbeat_loop())
+
+            try:
+                while self.is_active:
+                    await self.slots.acquire()
+                    started = False
+                    try:
+                        # Fetch next available task
+                        task = await self.fetch_eligible_task()
+
+                        if not task:
+                            # Long-poll timed out without work; ask again
+                            continue
+
+                        # Execute task in its own slot
+                        self._slot_runners[task["id"]] = asyncio.create_task(self._run_slot(task))
+                        started = True
+
+                    except Exception as e:
+                        await self.logger.log(
+                            "system_error",
+                            {
+                                "error": str(e),
+                                "stack_trace": traceback.format_exc()
+                            },
+                            level="ERROR"
+                        )
+                        await asyncio.sleep(5)  # Wait before retrying
+                    finally:
+                        if not started:
+                            self.slots.release()
+
+                if self._slot_runners:
+                    await asyncio.gather(*self._slot_runners.values(), return_exceptions=True)
+
+                await self.heartbeat()
+
+            finally:
+                heartbeats.cancel()
+                for runner in list(self._slot_runners.values()):
+                    runner.cancel()
+
+    async def _run_slot(self, task: dict):
+        """
+        Execute one task in a slot and free the slot afterwards.
+
+        Args:
+            task: Task dictionary as returned by fetch_task
+        """
+        try:
+            await self.execute_task_with_logging(task)
+        finally:
+            self._slot_runners.pop(task["id"], None)
+            self.slots.release()
+
+    def cancel_task(self, task_id: str, reason: str = "cancelled") -> bool:
+        """
+        Cancel a task running in one of this worker's slots.
+
+        The task is reported to the server as failed with the reason.
+
+        Args:
+            task_id: Task to cancel
+            reason: Reason recorded with the failure
+
+        Returns:
+            True if the task was running here
+        """
+        work = self._slot_work.get(task_id)
+        if work is None or work.done():
+            return False
+
+        self.current_tasks[task_id]["cancel_reason"] = reason
+        work.cancel()
+        return True
+
+    def emit_output(self, task_id: str, text: str):
+        """
+        Stream output of a running task to the server.
+
+        Chunks are queued (batched with other advisory calls, never
+        coalesced) and carry their offset, so a resent chunk isn't
+        duplicated, and the task's claims count, so the server drops
+        them once the task has been claimed again.
+
+        Args:
+            task_id: Task the output belongs to
+            text: Output to append
+        """
+        if not text:
+            return
+        offset = self._output_offsets.get(task_id, 0)
+        self._outputs.setdefault(task_id, []).append(text)
+        self._output_offsets[task_id] = offset + len(text)
+
+        self.mcp_client.queue_tool(
+            "append_task_output",
+            {
+                "task_id": task_id,
+                "worker_id": self.worker_id,
+                "offset": offset,
+                "text": text,
+                "epoch": self.current_tasks.get(task_id, {}).get("claims", 0)
+            }
+        )
+
+    async def upload_blob(self, data: bytes, media_type: Optional[str] = None) -> dict:
+        """
+        Upload content as a chunked artifact.
+
+        Args:
+            data: Content
+            media_type: Content type
+
+        Returns:
+            Reference to put in a task result ({"blob", "size", "chunks", "media_type"})
+
+        Raises:
+            RuntimeError: If the server rejects a chunk
+        """
+        chunks = []
+        for start in range(0, max(len(data), 1), UPLOAD_CHUNK_BYTES):
+            result = await self.mcp_client.call_tool(
+                "upload_blob_chunk",
+                {"data": base64.b64encode(data[start:start + UPLOAD_CHUNK_BYTES]).decode("ascii")}
+            )
+            if not result.get("success"):
+                raise RuntimeError(f"Blob upload failed: {result.get('message')}")
+            chunks.append(result["hash"])
 
-            while self.is_active:
-                try:
-                    # Fetch next available task
-                    task = await self.fetch_eligible_task()
-
-                    if not task:
-                        # No tasks available, wait before checking again
-                        await asyncio.sleep(2)
-                        continue
-
-                    # Execute task
-                    await self.execute_task_with_logging(task)
-
-                except Exception as e:
-                    await self.logger.log(
-                        "system_error",
-                        {
-                            "error": str(e),
-                            "stack_trace": traceback.format_exc()
-                        },
-                        level="ERROR"
-                    )
-                    await asyncio.sleep(5)  # Wait before retrying
+        result = await self.mcp_client.call_tool(
+            "commit_blob",
+            {"chunks": chunks, "media_type": media_type}
+        )
+        if not result.get("success"):
+            raise RuntimeError(f"Blob commit failed: {result.get('message')}")
+        return result["ref"]
+
+    async def offload_result(self, task_id: str, result: dict) -> dict:
+        """
+        Replace large parts of a result with blob references.
+
+        Large artifact contents are uploaded, and the task's full output
+        transcript is attached as result["output"].
+
+        Args:
+            task_id: Task the result belongs to
+            result: Result dictionary
+
+        Returns:
+            Result to send with complete_task
+        """
+        artifacts = []
+        for artifact in result.get("artifacts", []):
+            content = artifact.get("content") if isinstance(artifact, dict) else None
+            if isinstance(content, str) and len(content) > MAX_INLINE_ARTIFACT_CHARS:
+                ref = await self.upload_blob(content.encode("utf-8"), artifact.get("media_type", "text/plain; charset=utf-8"))
+                artifact = {key: value for key, value in artifact.items() if key != "content"}
+                artifact["content_ref"] = ref
+            artifacts.append(artifact)
+
+        result = {**result, "artifacts": artifacts}
+        transcript = "".join(self._outputs.get(task_id, []))
+        if transcript:
+            result["output"] = await self.upload_blob(transcript.encode("utf-8"), "text/plain; charset=utf-8")
+        return result
 
     async def fetch_eligible_task(self) -> Optional[dict]:
         """
         Fetch next task eligible for this worker.
 
+        Long-polls the server, which answers as soon as a matching
+        task becomes ready or after fetch_wait_seconds.
+
         Returns:
             Task dictionary or None if no tasks available
         """
@@ -231,12 +424,24 @@ class Worker:
                 "fetch_task",
                 {
                     "worker_id": self.worker_id,
-                    "capabilities": self.capabilities
+                    "capabilities": self.capabilities,
+                    "wait_seconds": self.fetch_wait_seconds
                 }
             )
 
             task = result.get("task")
 
+            # Tasks the server completed from the result cache on this claim
+            for task_id in result.get("cached_tasks", []):
+                await self.logger.log(
+                    "task_completed",
+                    {
+                        "task_id": task_id,
+                        "result_summary": "Reused cached result",
+                        "cache_hit": True
+                    }
+                )
+
             if task:
                 await self.logger.log(
                     "task_assigned",
@@ -258,17 +463,43 @@ class Worker:
                 },
                 level="ERROR"
             )
+            await asyncio.sleep(2)  # Back off before retrying
             return None
 
     async def execute_task_with_logging(self, task: dict):
         """
         Execute task with comprehensive logging.
 
+        The task is failed if it runs longer than its timeout_seconds
+        (the worker's unless the task sets its own), loses its lease,
+        or is cancelled with cancel_task.
+
+        Execution runs as a task.execute span under the task's trace
+        context, so its log entries and tool calls join the task's trace.
+
         Args:
             task: Task dictionary
         """
+        trace = task.get("trace")
+        parent = (trace["trace_id"], trace["span_id"]) if trace else None
+        with self.tracer.span("task.execute", parent=parent, task_id=task["id"], worker_id=self.worker_id) as span:
+            span["status"] = await self._execute_task(task)
+
+    async def _execute_task(self, task: dict) -> str:
+        """
+        Run a claimed task to completion or failure and report the outcome.
+
+        Args:
+            task: Task dictionary
+
+        Returns:
+            Status the task was reported with (completed or failed), or
+            lease_lost if the server reclaimed it first (nothing is
+            reported and neither counter moves)
+        """
         task_id = task["id"]
-        self.current_task = task
+        timeout = task.get("timeout_seconds") or self.timeout_seconds
+        self.current_tasks[task_id] = task
 
         await self.logger.log(
             "task_started",
@@ -285,21 +516,49 @@ class Worker:
                 {
                     "task_id": task_id,
                     "status": "in_progress",
-                    "progress": 0
+                    "progress": 0,
+                    "worker_id": self.worker_id
                 }
             )
 
-            # Execute task iteratively with progress updates
-            result = await self.execute_task_iterative(task)
+            # Execute task iteratively, renewing the lease in the background
+            work = asyncio.create_task(self.execute_task_iterative(task))
+            heartbeat = asyncio.create_task(self.renew_lease(task))
+            self._slot_work[task_id] = work
+            try:
+                done, _ = await asyncio.wait(
+                    {work, heartbeat},
+                    timeout=timeout,
+                    return_when=asyncio.FIRST_COMPLETED
+                )
+                if not done:
+                    work.cancel()
+                    raise TaskTimeoutError(f"Task {task_id} exceeded {timeout}s")
+                if heartbeat.done():
+                    work.cancel()
+                    heartbeat.result()
+                if work.cancelled():
+                    raise TaskCancelledError(task.get("cancel_reason", "cancelled"))
+                result = work.result()
+            finally:
+                heartbeat.cancel()
+                self._slot_work.pop(task_id, None)
+                if not work.done():
+                    work.cancel()
+
+            result = await self.offload_result(task_id, result)
 
             # Mark task as completed
-            await self.mcp_client.call_tool(
+            response = await self.mcp_client.call_tool(
                 "complete_task",
                 {
                     "task_id": task_id,
-                    "result": result
+                    "result": result,
+                    "worker_id": self.worker_id
                 }
             )
+            if not response.get("success"):
+                raise LeaseLostError(f"Lease on {task_id} was reclaimed before completion")
 
             self.tasks_completed += 1
 
@@ -310,6 +569,20 @@ class Worker:
                     "result_summary": self.summarize_result(result)
                 }
             )
+            return "completed"
+
+        except LeaseLostError as e:
+            # The task belongs to another attempt now, which reports its outcome
+            await self.logger.log(
+                "task_failed",
+                {
+                    "task_id": task_id,
+                    "error": str(e),
+                    "lease_lost": True
+                },
+                level="WARNING"
+            )
+            return "lease_lost"
 
         except Exception as e:
             # Mark task as failed
@@ -317,7 +590,8 @@ class Worker:
                 "fail_task",
                 {
                     "task_id": task_id,
-                    "error": str(e)
+                    "error": str(e),
+                    "worker_id": self.worker_id
                 }
             )
 
@@ -332,9 +606,40 @@ class Worker:
                 },
                 level="ERROR"
             )
+            return "failed"
 
         finally:
-            self.current_task = None
+            self.current_tasks.pop(task_id, None)
+            self._outputs.pop(task_id, None)
+            self._output_offsets.pop(task_id, None)
+
+    async def renew_lease(self, task: dict):
+        """
+        Periodically renew the lease on a claimed task.
+
+        Runs until cancelled. Raises LeaseLostError if the server has
+        handed the task to another worker.
+
+        Args:
+            task: Task dictionary as returned by fetch_task
+        """
+        interval = task.get("lease_seconds", 120) / 3
+
+        while True:
+            await asyncio.sleep(interval)
+
+            result = await self.mcp_client.call_tool(
+                "update_task_status",
+                {
+                    "task_id": task["id"],
+                    "status": "in_progress",
+                    "progress": task.get("progress", 0),
+                    "worker_id": self.worker_id
+                }
+            )
+
+            if not result.get("success"):
+                raise LeaseLostError(f"Lease on {task['id']} was reclaimed")
 
     async def execute_task_iterative(self, task: dict) -> dict:
         """
@@ -360,6 +665,7 @@ class Worker:
         steps = 5
         for step in range(1, steps + 1):
             progress = int((step / steps) * 100)
+            task["progress"] = progress
 
             await self.logger.log(
                 "task_progress",
@@ -368,17 +674,21 @@ class Worker:
                     "progress": progress,
                     "step": step,
                     "total_steps": steps
-                }
+                },
+                sanitized=True
             )
 
-            await self.mcp_client.call_tool(
+            self.mcp_client.queue_tool(
                 "update_task_status",
                 {
                     "task_id": task_id,
                     "status": "in_progress",
-                    "progress": progress
-                }
+                    "progress": progress,
+                    "worker_id": self.worker_id
+                },
+                key=task_id
             )
+            self.emit_output(task_id, f"[step {step}/{steps}] {description}\n")
 
             # Simulate work
             await asyncio.sleep(2)
@@ -416,17 +726,26 @@ class Worker:
             }
         )
 
-    def progress_bar(self) -> str:
+    @property
+    def current_task(self) -> Optional[dict]:
+        """Oldest task currently running in a slot, if any."""
+        return next(iter(self.current_tasks.values()), None)
+
+    def progress_bar(self, task: Optional[dict] = None) -> str:
         """
-        Generate progress bar for current task.
+        Generate progress bar for a running task.
+
+        Args:
+            task: Task to render (defaults to current_task)
 
         Returns:
             Progress bar string
         """
-        if not self.current_task:
+        task = task or self.current_task
+        if not task:
             return "[░░░░░] 0%"
 
-        progress = self.current_task.get("progress", 0)
+        progress = task.get("progress", 0)
         filled = int(progress / 20)  # 5 segments for 100%
         bar = "▓" * filled + "░" * (5 - filled)
 
@@ -436,8 +755,48 @@ class Worker:
     def status(self) -> str:
         """Get worker status string."""
         if not self.is_active:
-            return "STOPPED"
-        elif self.current_task:
+            return "DRAINING" if self.current_tasks else "STOPPED"
+        elif len(self.current_tasks) >= self.max_concurrent_tasks:
             return "BUSY"
+        elif self.current_tasks:
+            return "ACTIVE"
         else:
             return "IDLE"
+
+
+def create_worker(
+    worker_id: str,
+    worker_type: WorkerType,
+    config,
+    mcp_host: str,
+    mcp_port: int,
+    log_file: str
+) -> Worker:
+    """
+    Create a worker, applying the configured profile for its type.
+
+    Args:
+        worker_id: Unique worker identifier
+        worker_type: Worker type
+        config: ProjectConfig (worker profiles are read from it)
+        mcp_host: MCP server host
+        mcp_port: MCP server port
+        log_file: Path to log file
+
+    Returns:
+        Worker instance
+    """
+    profile = next(
+        (p for p in config.worker_profiles if p.get("type") == worker_type.value),
+        {}
+    )
+
+    return Worker(
+        worker_id=worker_id,
+        worker_type=worker_type,
+        mcp_host=mcp_host,
+        mcp_port=mcp_port,
+        log_file=log_file,
+        max_concurrent_tasks=profile.get("max_concurrent_tasks"),
+        timeout_seconds=profile.get("timeout_seconds")
+    )